@@ -0,0 +1,21 @@
+/**
+ * @file crypto_benchmark.h
+ * @brief Cycle counts of the crypto primitives against their old versions
+ * @version 0.1
+ *
+ * Built with -DCRYPTO_BENCHMARK the AP prints these once at start up
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CRYPTO_BENCH
+#define CRYPTO_BENCH
+
+/**
+ * @brief Print the cycles each benchmarked primitive takes
+ *
+ */
+void print_crypto_benchmark();
+
+#endif /* CRYPTO_BENCH */
@@ -35,6 +35,16 @@ void recv_input(const char *msg, char *buf, size_t buflen);
  */
 void recv_input(const char *msg, uint8_t *buf, size_t buflen);
 
+/**
+ * @brief Sets work to do while waiting for the host to send a message
+ *
+ * Before each message recv_input calls the task until the host starts sending
+ * or the task returns false because it has nothing left to do
+ *
+ * @param task The work to do, nullptr for none
+ */
+void set_input_idle_task(bool (*task)());
+
 /**
  * @brief Prints a buffer of bytes as a hex string
  *
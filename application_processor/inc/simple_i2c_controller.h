@@ -14,6 +14,7 @@
 
 #include "errors.h"
 #include "host_messaging.h"
+#include "i2c_trace.h"
 #include "mxc.h"
 #include "packets.h"
 
@@ -23,53 +24,404 @@ namespace i2c {
     // I2C frequency in HZ
     constexpr const uint32_t I2C_FREQ = 100000;
 
+    // Fastest bus speed the AP will negotiate with a component
+    constexpr const i2c_speed_t I2C_MAX_SPEED = i2c_speed_t::FAST_PLUS;
+
+    // Size of a transfer when not using length framing
+    constexpr const uint32_t I2C_FIXED_FRAME = 256;
+
+    // Only put the real frame length on the wire instead of a fixed frame
+    constexpr const bool I2C_LENGTH_FRAMING = true;
+
+    // Write commands and poll for the response instead of holding the bus
+    // while the component processes them. Built with -DI2C_ASYNC_DMA commands
+    // are sent as one DMA write/read exchange instead
+#ifdef I2C_ASYNC_DMA
+    constexpr const bool I2C_DEFERRED_PROCESSING = false;
+#else
+    constexpr const bool I2C_DEFERRED_PROCESSING = true;
+#endif
+
+    // Time between polls of a component processing a command
+    constexpr const uint32_t I2C_POLL_INTERVAL_US = 200;
+
+    // Polls before giving up on a component, about two seconds
+    constexpr const uint32_t I2C_POLL_LIMIT = 10000;
+
     using i2c_addr_t = uint8_t;
 
+    // General call address, received by every component on the bus
+    constexpr const i2c_addr_t I2C_GENERAL_CALL = 0x00;
+
+    /**
+     * @brief Number of bytes clocked on the wire for a packet type
+     *
+     * @tparam T Packet type
+     * @param framed Whether length framing is used
+     * @return uint32_t Number of bytes in the transfer
+     */
+    template<packet_type_t T>
+    constexpr uint32_t wire_len(const bool framed = I2C_LENGTH_FRAMING) {
+        return framed ? frame_size<T>() : I2C_FIXED_FRAME;
+    }
+
+    /**
+     * @brief Estimated bus time of a write/read exchange
+     *
+     * Every byte (including the address byte) costs 9 SCL cycles, plus one
+     * cycle each for START, repeated START and STOP
+     *
+     * @param tx_len Bytes written
+     * @param rx_len Bytes read
+     * @param freq Bus frequency in Hz
+     * @return uint32_t Bus time in microseconds
+     */
+    constexpr uint32_t bus_time_us(const uint32_t tx_len, const uint32_t rx_len,
+                                   const uint32_t freq = I2C_FREQ) {
+        return static_cast<uint32_t>(
+            ((9ULL * (tx_len + 1 + rx_len + 1) + 3) * 1000000ULL) / freq);
+    }
+
     /**
      * @brief Initialize the I2C Connection
      *
      */
     error_t i2c_simple_controller_init();
 
+    /**
+     * @brief Timestamps of an exchange being traced
+     *
+     */
+    struct trace_point_t {
+        packet_type_t type;
+        uint32_t start;   // Before the bus clock is selected
+        uint32_t issued;  // Handed to the I2C driver
+    };
+
+    /**
+     * @brief Print min/avg/max cycles of every traced phase per packet type
+     *
+     * The address and data phases are the ideal bus time at the selected
+     * clock, whatever the exchange took beyond that is reported as stretch:
+     * the component holding SCL low while it computes plus driver overhead
+     *
+     */
+    void print_i2c_trace();
+
+    /**
+     * @brief Print the bus time of every exchange with and without length
+     * framing
+     *
+     */
+    void print_framing_benchmark();
+
+    /**
+     * @brief Set the negotiated bus speed for an address
+     *
+     * @param addr I2C Address
+     * @param speed Bus speed to use for future transactions
+     */
+    void set_speed(const i2c_addr_t addr, const i2c_speed_t speed);
+
+    /**
+     * @brief Get the negotiated bus speed for an address
+     *
+     * @param addr I2C Address
+     * @return i2c_speed_t Bus speed used for transactions
+     */
+    i2c_speed_t get_speed(const i2c_addr_t addr);
+
+    /**
+     * @brief Switch the bus clock to the negotiated speed of an address
+     *
+     * @param addr I2C Address
+     */
+    void select_speed(const i2c_addr_t addr);
+
+    /**
+     * @brief Check whether a device ACKs an address
+     *
+     * Sends only the address byte (zero-length write) followed by a STOP, or
+     * by a repeated START of the next probe when holding the bus
+     *
+     * @param addr I2C Address
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return error_t SUCCESS if the address was ACKed
+     */
+    error_t probe(const i2c_addr_t addr, const bool hold = false);
+
+    /**
+     * @brief Send a STOP to release a bus held by an earlier transaction
+     *
+     * Must be called if a chain of held transactions is abandoned early
+     */
+    void release_bus();
+
+    // Buffers packets are built and received in place in
+    extern uint8_t txbuf[I2C_FIXED_FRAME];
+    extern uint8_t rxbuf[I2C_FIXED_FRAME];
+
+    /**
+     * @brief Perform a transaction from txbuf into rxbuf
+     *
+     * The write and read are combined with a repeated START so the command
+     * and response share one bus acquisition. A zero tx_len only reads and a
+     * zero rx_len only writes. On failure the magic byte of rxbuf is set to
+     * ERROR and the bus is released
+     *
+     * When hold is set the transaction ends without a STOP and the next
+     * transaction starts with a repeated START, chaining exchanges with
+     * several components. The last transaction of a chain must not hold
+     *
+     * @param addr I2C Address
+     * @param type Packet type the exchange is traced as
+     * @param tx_len Bytes to write
+     * @param rx_len Bytes to read
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return error_t Whether the transaction succeeded
+     */
+    error_t transfer(const i2c_addr_t addr, const packet_type_t type,
+                     const uint32_t tx_len, const uint32_t rx_len,
+                     const bool hold = false);
+
+    /**
+     * @brief Start building a packet in place in the transmit buffer
+     *
+     * @tparam T Packet type to send
+     * @return packet_writer_t<T> Writer over the transmit buffer
+     */
+    template<packet_type_t T> packet_writer_t<T> begin_packet() {
+        memset(txbuf, 0, wire_len<T>());
+        return packet_writer_t<T>(txbuf);
+    }
+
     /**
      * @brief Perform an I2C Transaction
      *
      * @tparam R Expected packet type
+     * @tparam T Packet type to send, built in txbuf with begin_packet
+     * @param addr I2C Address
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return packet_view_t<R> View of the received packet, valid until the
+     * next transaction
+     */
+    template<packet_type_t R, packet_type_t T>
+    packet_view_t<R> send_i2c_master_tx(const i2c_addr_t addr,
+                                        const bool hold = false) {
+        transfer(addr, T, wire_len<T>(), wire_len<R>(), hold);
+        return packet_view_t<R>(rxbuf);
+    }
+
+    /**
+     * @brief Perform a write-only I2C Transaction
+     *
+     * @tparam T Packet type to send, built in txbuf with begin_packet
+     * @param addr I2C Address, may be I2C_GENERAL_CALL
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return error_t Whether the packet was ACKed
+     */
+    template<packet_type_t T>
+    error_t send_i2c_master_write(const i2c_addr_t addr,
+                                  const bool hold = false) {
+        return transfer(addr, T, wire_len<T>(), 0, hold);
+    }
+
+    /**
+     * @brief Perform a read-only I2C Transaction
+     *
+     * Used to collect a response prepared by an earlier write, such as a
+     * broadcast
+     *
+     * @tparam R Expected packet type
+     * @param addr I2C Address
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return packet_view_t<R> View of the received packet, valid until the
+     * next transaction
+     */
+    template<packet_type_t R>
+    packet_view_t<R> recv_i2c_master_read(const i2c_addr_t addr,
+                                          const bool hold = false) {
+        transfer(addr, R, 0, wire_len<R>(), hold);
+        return packet_view_t<R>(rxbuf);
+    }
+
+    /**
+     * @brief Wait until a component has the response to a command ready
+     *
+     * Each poll reads a single byte, which is BUSY while the command is still
+     * being processed. The bus is released between polls
+     *
+     * @param addr I2C Address
+     * @return error_t SUCCESS once the response can be read
+     */
+    error_t wait_response(const i2c_addr_t addr);
+
+    /**
+     * @brief Read the response to a command once the component has it ready
+     *
+     * @tparam R Expected packet type
+     * @param addr I2C Address
+     * @param hold Keep the bus for another transaction instead of a STOP
+     * @return packet_view_t<R> View of the received packet, valid until the
+     * next transaction
+     */
+    template<packet_type_t R>
+    packet_view_t<R> recv_i2c_master_response(const i2c_addr_t addr,
+                                              const bool hold = false) {
+        if (wait_response(addr) != error_t::SUCCESS) {
+            rxbuf[magic_offset] = static_cast<uint8_t>(packet_magic_t::ERROR);
+            return packet_view_t<R>(rxbuf);
+        }
+        return recv_i2c_master_read<R>(addr, hold);
+    }
+
+    /**
+     * @brief State of an asynchronous I2C transaction
+     *
+     * The DMA engine reads and writes the buffers in the background until the
+     * transaction is awaited
+     */
+    struct async_state_t {
+        mxc_i2c_req_t request;  // Must be first, see async_complete
+        volatile bool done;
+        volatile int error;
+        trace_point_t trace;
+        // The next command is built in one buffer while the other is sent
+        uint8_t txbufs[2][I2C_FIXED_FRAME];
+        uint8_t next;
+        uint8_t rxbuf[I2C_FIXED_FRAME];
+    };
+
+    /**
+     * @brief State of the asynchronous transaction in flight
+     *
+     * Only referenced from the DMA path, so with deferred processing it is
+     * never instantiated and takes no RAM
+     *
+     * @return async_state_t& The single async state
+     */
+    inline async_state_t &async_state() {
+        static async_state_t state = {};
+        return state;
+    }
+
+    /**
+     * @brief Start a DMA transaction from the buffers in an async state
+     *
+     * @param state Transaction state with the next txbuf filled in
+     * @param addr I2C Address
+     * @param type Packet type the exchange is traced as
+     * @param tx_len Bytes to write
+     * @param rx_len Bytes to read
+     * @return error_t Whether the transaction was started
+     */
+    error_t start_async(async_state_t &state, const i2c_addr_t addr,
+                        const packet_type_t type, const uint32_t tx_len,
+                        const uint32_t rx_len);
+
+    /**
+     * @brief Wait for an asynchronous transaction to complete
+     *
+     * @param state Transaction state
+     * @return int MXC error code of the transaction
+     */
+    int wait_async(async_state_t &state);
+
+    /**
+     * @brief Start an I2C Transaction without waiting for it to finish
+     *
+     * Only one transaction can be on the bus at a time, it must be awaited
+     * before starting another transaction
+     *
+     * @tparam R Expected packet type
+     * @tparam T Packet type to send, built with begin_command
+     * @param addr I2C Address
+     * @return error_t Whether the transaction was started
+     */
+    template<packet_type_t R, packet_type_t T>
+    error_t send_i2c_master_tx_async(const i2c_addr_t addr) {
+        return start_async(async_state(), addr, T, wire_len<T>(),
+                           wire_len<R>());
+    }
+
+    /**
+     * @brief Wait for an asynchronous I2C Transaction
+     *
+     * @tparam R Expected packet type
+     * @return packet_view_t<R> View of the received packet, valid until the
+     * next asynchronous transaction
+     */
+    template<packet_type_t R> packet_view_t<R> await_i2c_master_tx() {
+        async_state_t &state = async_state();
+        if (wait_async(state) != E_NO_ERROR) {
+            state.rxbuf[magic_offset] =
+                static_cast<uint8_t>(packet_magic_t::ERROR);
+        }
+        return packet_view_t<R>(state.rxbuf);
+    }
+
+    /**
+     * @brief Start building a command in place in the buffer start_command
+     * sends it from
+     *
+     * The buffer is free again as soon as start_command returns, so the next
+     * command can be built while the component processes the current one
+     *
      * @tparam T Packet type to send
+     * @return packet_writer_t<T> Writer over the command buffer
+     */
+    template<packet_type_t T> packet_writer_t<T> begin_command() {
+        if constexpr (I2C_DEFERRED_PROCESSING) {
+            return begin_packet<T>();
+        } else {
+            async_state_t &state = async_state();
+            uint8_t *const buf = state.txbufs[state.next];
+            memset(buf, 0, wire_len<T>());
+            return packet_writer_t<T>(buf);
+        }
+    }
+
+    /**
+     * @brief Send a command without waiting for the response
+     *
+     * With deferred processing the command is written on its own and the
+     * component processes it outside its ISR, otherwise it is sent as a DMA
+     * transaction. Either way the bus is free for other components until the
+     * response is collected with finish_command
+     *
+     * @tparam R Expected packet type
+     * @tparam T Packet type to send, built with begin_command
      * @param addr I2C Address
-     * @param packet Packet to send
-     * @return packet_t<R> Received packet
+     * @return error_t Whether the command was sent
      */
     template<packet_type_t R, packet_type_t T>
-    packet_t<R> send_i2c_master_tx(const i2c_addr_t addr, packet_t<T> packet) {
-        uint8_t rxbuf[256] = {};
-        uint8_t txbuf[256] = {};
-        packet_t<R> rx_packet = {};
-
-        memcpy(&txbuf[0], &packet.header.magic, sizeof(packet_magic_t));
-        memcpy(&txbuf[1], &packet.header.checksum, sizeof(uint32_t));
-        memcpy(&txbuf[5], &packet.payload, sizeof(payload_t<T>));
-
-        mxc_i2c_req_t request;
-        request.i2c = MXC_I2C1;
-        request.addr = addr;
-        request.tx_len = 256;
-        request.tx_buf = txbuf;
-        request.rx_len = 256;
-        request.rx_buf = rxbuf;
-        request.restart = 0;
-        request.callback = nullptr;
-
-        const int error = MXC_I2C_MasterTransaction(&request);
-        if (error == E_NO_ERROR) {
-            rx_packet.header.magic = static_cast<packet_magic_t>(rxbuf[0]);
-            memcpy(&rx_packet.header.checksum, &rxbuf[1], sizeof(uint32_t));
-            memcpy(&rx_packet.payload, &rxbuf[5], sizeof(payload_t<R>));
-            return rx_packet;
+    error_t start_command(const i2c_addr_t addr) {
+        if constexpr (I2C_DEFERRED_PROCESSING) {
+            return transfer(addr, T, wire_len<T>(), 0);
+        } else {
+            return send_i2c_master_tx_async<R, T>(addr);
+        }
+    }
+
+    /**
+     * @brief Collect the response to a command sent with start_command
+     *
+     * A component that queued the command answers the DMA exchange with BUSY,
+     * the response is then polled for like a deferred one
+     *
+     * @tparam R Expected packet type
+     * @param addr I2C Address the command was sent to
+     * @return packet_view_t<R> View of the received packet, valid until the
+     * next transaction
+     */
+    template<packet_type_t R>
+    packet_view_t<R> finish_command(const i2c_addr_t addr) {
+        if constexpr (I2C_DEFERRED_PROCESSING) {
+            return recv_i2c_master_response<R>(addr);
         } else {
-            packet_t<R> error_packet = {};
-            error_packet.header.magic = packet_magic_t::ERROR;
-            return error_packet;
+            const packet_view_t<R> rx_packet = await_i2c_master_tx<R>();
+            if (rx_packet.magic() != packet_magic_t::BUSY) { return rx_packet; }
+            return recv_i2c_master_response<R>(addr);
         }
     }
 
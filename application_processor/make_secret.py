@@ -2,6 +2,9 @@ import secrets
 
 from cryptography.hazmat.backends import default_backend
 
+from cryptography.hazmat.primitives.asymmetric import ec
+from cryptography.hazmat.primitives.asymmetric.utils import decode_dss_signature
+
 from cryptography.hazmat.primitives.ciphers import Cipher
 from cryptography.hazmat.primitives.ciphers.algorithms import AES
 from cryptography.hazmat.primitives.ciphers.modes import CTR
@@ -55,6 +58,45 @@ def parse_global_attest() -> tuple[bytes, bytes]:
     return attest_key_unwrapped, attest_nonce
 
 
+def parse_global_key(name: str) -> bytes:
+    """Parse a key array from the deployment secrets
+
+    Args:
+        name (str): Variable name of the key
+
+    Raises:
+        ValueError: If the key is missing
+
+    Returns:
+        bytes: The key
+    """
+    lines: list[str] = open(
+        "../deployment/global_secrets_secure.h", "rt", encoding="utf-8"
+    ).readlines()
+    for line in lines:
+        if f" {name}[" in line:
+            values = line.split("{")[1].split("}")[0].strip(",").split(",")
+            return bytes(int(value) for value in values)
+    raise ValueError(f"Missing {name}")
+
+
+def sign(message: bytes, key: bytes) -> bytes:
+    """Sign a message the way uECC_sign does over its SHA-256 hash
+
+    Args:
+        message (bytes): Message to sign
+        key (bytes): Big-endian secp256r1 private key
+
+    Returns:
+        bytes: Raw r || s signature
+    """
+    private_key = ec.derive_private_key(
+        int.from_bytes(key, "big"), ec.SECP256R1(), default_backend()
+    )
+    r, s = decode_dss_signature(private_key.sign(message, ec.ECDSA(SHA256())))
+    return r.to_bytes(32, "big") + s.to_bytes(32, "big")
+
+
 def hash_pin(pin: int, iterations: int) -> bytes:
     """Hashes the attestation pin
 
@@ -152,6 +194,14 @@ write("uint32_t", "ITERATIONS", [f"{ITERATIONS}"])
 write("uint8_t[]", "ATTEST_WRAPPER_NONCE", [f"{b}" for b in attest_nonce])
 write("uint8_t[]", "ATTEST_KEY_WRAPPED", [f"{b}" for b in attest_key_wrapped])
 
+# The ATTEST commands for positions 1-3 never change, so they are signed here
+# rather than on every attest
+attest_priv = parse_global_key("ATTEST_A_PRIV")
+attest_cmd_sigs = b"".join(
+    sign(b"ATTEST" + bytes([position]), attest_priv) for position in range(1, 4)
+)
+write("uint8_t[]", "ATTEST_CMD_SIGS", [f"{b}" for b in attest_cmd_sigs])
+
 attest_pin = attest_pin.hex()
 replacement_token = replacement_token.hex()
 
@@ -27,6 +27,15 @@ VPATH+=../lib/tinycrypt/src
 
 #PROJ_CFLAGS+=-Wall -Wextra -s -fomit-frame-pointer -fno-unwind-tables -fno-asynchronous-unwind-tables -fno-math-errno -fno-ident -ffast-math -nostdlib -nostdinc++
 PROJ_CFLAGS+=-Wall -s -fomit-frame-pointer -fno-unwind-tables -fno-asynchronous-unwind-tables -fno-math-errno -fno-ident -ffast-math -nostdlib -nostdinc++
+
+# Print I2C bus timing benchmarks at startup
+#PROJ_CFLAGS+=-DI2C_BENCHMARK
+
+# Trace I2C exchanges with the DWT cycle counter, printed after each command
+#PROJ_CFLAGS+=-DI2C_TRACE
+
+# Send commands as DMA write/read exchanges instead of writing and polling
+#PROJ_CFLAGS+=-DI2C_ASYNC_DMA
 # ****************** eCTF Bootloader *******************
 # DO NOT REMOVE
 LINKERFILE=firmware.ld
@@ -13,11 +13,13 @@
 
 #include "board.h"
 #include "crc32.h"
+#include "crypto_benchmark.h"
 #include "errors.h"
 #include "host_messaging.h"
 #include "i2c.h"
 #include "icc.h"
 #include "led.h"
+#include "nonce_pool.h"
 #include "packets.h"
 #include "random.h"
 #include "simple_flash.h"
@@ -31,6 +33,7 @@
 #include "tinycrypt/sha256.h"
 #include "utils.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -66,9 +69,18 @@ static uint8_t shared_secrets[COMPONENT_CNT][32] = {};
 static uint8_t private_keys[COMPONENT_CNT][32] = {};
 static uint8_t public_keys[COMPONENT_CNT][64] = {};
 static uint32_t nonces[COMPONENT_CNT] = {};
-static uint8_t aes_keys[COMPONENT_CNT][16] = {};
+static tc_aes_session_struct aes_sessions[COMPONENT_CNT] = {};
 static uint8_t ctrs[COMPONENT_CNT][16] = {};
 
+// HMAC_KEY's padded blocks, hashed once per key exchange
+static tc_hmac_midstate_struct hmac_midstate = {};
+
+// Boot every component with a single general call challenge
+constexpr const bool BROADCAST_BOOT = true;
+
+// One precomputed nonce per signature a boot makes
+static nonce_pool_t<BROADCAST_BOOT ? 1 : COMPONENT_CNT> sign_nonces;
+
 static inline uint8_t addr_to_idx(const i2c_addr_t addr) {
     for (uint8_t i = 0; i < COMPONENT_CNT; ++i) {
         if (component_id_to_i2c_addr(flash_status.component_ids[i]) == addr) {
@@ -96,7 +108,6 @@ static int secure_send(const uint8_t address, const uint8_t *const buffer,
     const uint8_t index = addr_to_idx(address);
 
     uint8_t payload[sizeof(payload_t<packet_type_t::SECURE>)] = {};
-    tc_aes_key_sched_struct aes_key = {};
     tc_hmac_state_struct hmac_ctx = {};
 
     uint8_t hmac[32] = {};
@@ -106,59 +117,54 @@ static int secure_send(const uint8_t address, const uint8_t *const buffer,
         return -1;
     }
 
-    packet_t<packet_type_t::SECURE> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::ENCRYPTED;
+    packet_writer_t<packet_type_t::SECURE> tx_packet =
+        begin_packet<packet_type_t::SECURE>();
+    tx_packet.set_magic(packet_magic_t::ENCRYPTED);
 
-    payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
-    payload[1] = len;
-    memcpy(&payload[2], &nonces[index], 0x04);
-    memcpy(&payload[6], buffer, len);
+    // Built and then encrypted in place in the TX buffer
+    uint8_t *const tx_payload =
+        reinterpret_cast<uint8_t *>(&tx_packet.payload());
+    constexpr const uint32_t payload_len = sizeof(tx_packet.payload());
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
-    memcpy(&payload[sizeof(payload) - 32], hmac, 32);
+    tx_payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
+    tx_payload[1] = len;
+    memcpy(&tx_payload[2], &nonces[index], 0x04);
+    memcpy(&tx_payload[6], buffer, len);
 
-    tc_aes128_set_encrypt_key(&aes_key, aes_keys[index]);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&tx_packet.payload),
-                sizeof(tx_packet.payload), payload, sizeof(payload),
-                ctrs[index], &aes_key);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &tx_payload[0], payload_len - 32);
+    tc_hmac_final_midstate(&tx_payload[payload_len - 32], 32, &hmac_ctx,
+                           &hmac_midstate);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tc_ctr_mode_session(tx_payload, payload_len, tx_payload, payload_len,
+                        ctrs[index], &aes_sessions[index]);
 
-    const packet_t<packet_type_t::SECURE> rx_packet =
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+
+    const packet_view_t<packet_type_t::SECURE> rx_packet =
         send_i2c_master_tx<packet_type_t::SECURE, packet_type_t::SECURE>(
-            address, tx_packet);
+            address);
 
-    if (rx_packet.header.magic == packet_magic_t::ERROR) {
+    if (rx_packet.magic() == packet_magic_t::ERROR) {
         print_error("Error :(\n");
         return -1;
     }
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-
-    if (rx_packet.header.magic != packet_magic_t::ENCRYPTED) {
-        // Invalid magic
-        print_error("Error :(\n");
-        return -1;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_packet.valid()) {
+        // Invalid packet
         print_error("Error :(\n");
         return -1;
     }
 
-    tc_aes128_set_encrypt_key(&aes_key, aes_keys[index]);
-    tc_ctr_mode(payload, sizeof(payload),
-                reinterpret_cast<const uint8_t *>(&rx_packet.payload),
-                sizeof(rx_packet.payload), ctrs[index], &aes_key);
+    tc_ctr_mode_session(
+        payload, sizeof(payload),
+        reinterpret_cast<const uint8_t *>(&rx_packet.payload()),
+        sizeof(rx_packet.payload()), ctrs[index], &aes_sessions[index]);
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
     tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
+    tc_hmac_final_midstate(hmac, 32, &hmac_ctx, &hmac_midstate);
 
     if (payload[0] != static_cast<uint8_t>(packet_magic_t::DECRYPTED)) {
         // Invalid payload
@@ -197,7 +203,6 @@ static int secure_receive(const i2c_addr_t address, uint8_t *const buffer) {
     const uint8_t index = addr_to_idx(address);
 
     uint8_t payload[sizeof(payload_t<packet_type_t::SECURE>)] = {};
-    tc_aes_key_sched_struct aes_key = {};
     tc_hmac_state_struct hmac_ctx = {};
 
     uint8_t hmac[32] = {};
@@ -207,58 +212,53 @@ static int secure_receive(const i2c_addr_t address, uint8_t *const buffer) {
         return -1;
     }
 
-    packet_t<packet_type_t::SECURE_REQ> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::ENCRYPTED_REQ;
+    packet_writer_t<packet_type_t::SECURE_REQ> tx_packet =
+        begin_packet<packet_type_t::SECURE_REQ>();
+    tx_packet.set_magic(packet_magic_t::ENCRYPTED_REQ);
 
-    payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
-    payload[1] = 0;
-    memcpy(&payload[2], &nonces[index], 0x04);
+    // Built and then encrypted in place in the TX buffer
+    uint8_t *const tx_payload =
+        reinterpret_cast<uint8_t *>(&tx_packet.payload());
+    constexpr const uint32_t payload_len = sizeof(tx_packet.payload());
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
-    memcpy(&payload[sizeof(payload) - 32], hmac, 32);
+    tx_payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
+    tx_payload[1] = 0;
+    memcpy(&tx_payload[2], &nonces[index], 0x04);
+
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &tx_payload[0], payload_len - 32);
+    tc_hmac_final_midstate(&tx_payload[payload_len - 32], 32, &hmac_ctx,
+                           &hmac_midstate);
 
-    tc_aes128_set_encrypt_key(&aes_key, aes_keys[index]);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&tx_packet.payload),
-                sizeof(tx_packet.payload), payload, sizeof(payload),
-                ctrs[index], &aes_key);
+    tc_ctr_mode_session(tx_payload, payload_len, tx_payload, payload_len,
+                        ctrs[index], &aes_sessions[index]);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-    const packet_t<packet_type_t::SECURE> rx_packet =
+    const packet_view_t<packet_type_t::SECURE> rx_packet =
         send_i2c_master_tx<packet_type_t::SECURE, packet_type_t::SECURE_REQ>(
-            address, tx_packet);
+            address);
 
-    if (rx_packet.header.magic == packet_magic_t::ERROR) {
+    if (rx_packet.magic() == packet_magic_t::ERROR) {
         print_error("Error :(\n");
         return -1;
     }
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-
-    if (rx_packet.header.magic != packet_magic_t::ENCRYPTED) {
-        // Invalid magic
-        print_error("Error :(\n");
-        return -1;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_packet.valid()) {
+        // Invalid packet
         print_error("Error :(\n");
         return -1;
     }
 
-    tc_aes128_set_encrypt_key(&aes_key, aes_keys[index]);
-    tc_ctr_mode(payload, sizeof(payload),
-                reinterpret_cast<const uint8_t *>(&rx_packet.payload),
-                sizeof(rx_packet.payload), ctrs[index], &aes_key);
+    tc_ctr_mode_session(
+        payload, sizeof(payload),
+        reinterpret_cast<const uint8_t *>(&rx_packet.payload()),
+        sizeof(rx_packet.payload()), ctrs[index], &aes_sessions[index]);
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
     tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
+    tc_hmac_final_midstate(hmac, 32, &hmac_ctx, &hmac_midstate);
 
     if (payload[0] != static_cast<uint8_t>(packet_magic_t::DECRYPTED)) {
         // Invalid payload
@@ -302,6 +302,9 @@ static error_t init() {
     flash_simple_init();
     random_init();
 
+    // Precompute signing nonces while waiting for the host
+    set_input_idle_task([]() { return sign_nonces.fill(); });
+
     flash_simple_read(FLASH_ADDR, &flash_status, sizeof(flash_entry_t));
 
     if (flash_status.flash_magic != FLASH_MAGIC) {
@@ -322,98 +325,327 @@ static error_t init() {
     return error_t::SUCCESS;
 }
 
-static error_t list_components() {
-    for (uint32_t i = 0; i < flash_status.component_cnt; ++i) {
-        print_info("P>0x%08lx\n", flash_status.component_ids[i]);
+/**
+ * @brief Exchange a LIST command with an address
+ *
+ * @param addr I2C address to query
+ * @param component_id Component ID of the responder
+ * @param speed Fastest bus speed supported by both ends
+ * @return error_t Whether a valid component responded
+ */
+static error_t list_exchange(const i2c_addr_t addr,
+                             uint32_t *const component_id,
+                             i2c_speed_t *const speed) {
+    packet_writer_t<packet_type_t::LIST_COMMAND> tx_packet =
+        begin_command<packet_type_t::LIST_COMMAND>();
+    tx_packet.set_magic(packet_magic_t::LIST);
+    tx_packet.payload().len = 0x00;
+    tx_packet.payload().speed = I2C_MAX_SPEED;
+
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+
+    if (start_command<packet_type_t::LIST_ACK, packet_type_t::LIST_COMMAND>(
+            addr) != error_t::SUCCESS) {
+        return error_t::ERROR;
     }
+    const packet_view_t<packet_type_t::LIST_ACK> rx_packet =
+        finish_command<packet_type_t::LIST_ACK>(addr);
 
-    for (i2c_addr_t addr = 0x08; addr < 0x78; ++addr) {
-        if (addr == 0x18 || addr == 0x28 || addr == 0x36) { continue; }
+    if (rx_packet.magic() == packet_magic_t::ERROR) {
+        return error_t::ERROR;
+    }
+
+    if (!rx_packet.valid()) {
+        // Invalid packet
+        return error_t::ERROR;
+    } else if (rx_packet.payload().len != 0x04) {
+        // Invalid payload length
+        return error_t::ERROR;
+    }
+
+    memcpy(component_id, rx_packet.payload().data, 0x04);
+    *speed = rx_packet.payload().speed > I2C_MAX_SPEED
+                 ? I2C_MAX_SPEED
+                 : rx_packet.payload().speed;
+    return error_t::SUCCESS;
+}
 
-        packet_t<packet_type_t::LIST_COMMAND> tx_packet = {};
-        tx_packet.header.magic = packet_magic_t::LIST;
-        tx_packet.payload.len = 0x00;
+/**
+ * @brief Move a component to the fastest bus speed both ends support
+ *
+ * The new speed is verified with a second LIST exchange, if that fails the
+ * component is left in standard mode
+ *
+ * @param addr I2C address of the component
+ * @param component_id Component ID of the responder
+ * @return error_t Whether a valid component responded
+ */
+static error_t negotiate_speed(const i2c_addr_t addr,
+                               uint32_t *const component_id) {
+    i2c_speed_t speed = i2c_speed_t::STANDARD;
+    if (list_exchange(addr, component_id, &speed) != error_t::SUCCESS) {
+        return error_t::ERROR;
+    }
+    if (speed == get_speed(addr)) { return error_t::SUCCESS; }
 
-        tx_packet.header.checksum =
-            calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    set_speed(addr, speed);
+    if (speed == i2c_speed_t::STANDARD) { return error_t::SUCCESS; }
 
-        const packet_t<packet_type_t::LIST_ACK> rx_packet =
-            send_i2c_master_tx<packet_type_t::LIST_ACK,
-                               packet_type_t::LIST_COMMAND>(addr, tx_packet);
+    uint32_t verify_id = 0;
+    if (list_exchange(addr, &verify_id, &speed) != error_t::SUCCESS ||
+        verify_id != *component_id) {
+        set_speed(addr, i2c_speed_t::STANDARD);
+    }
+    return error_t::SUCCESS;
+}
 
-        if (rx_packet.header.magic == packet_magic_t::ERROR) { continue; }
+static error_t list_components() {
+    for (uint32_t i = 0; i < flash_status.component_cnt; ++i) {
+        print_info("P>0x%08lx\n", flash_status.component_ids[i]);
+    }
 
-        const uint32_t expected_checksum =
-            calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
+    // Only addresses that ACK get a full LIST exchange
+    i2c_addr_t found[0x78] = {};
+    uint32_t found_cnt = 0;
 
-        if (rx_packet.header.magic != packet_magic_t::LIST_ACK) {
-            // Invalid response
-            continue;
-        } else if (rx_packet.header.checksum != expected_checksum) {
-            // Invalid checksum
-            continue;
-        } else if (rx_packet.payload.len != 0x04) {
-            // Invalid payload length
-            continue;
+    // Probes are chained with repeated STARTs, only the last one sends a STOP
+    for (i2c_addr_t addr = 0x08; addr < 0x78; ++addr) {
+        if (addr == 0x18 || addr == 0x28 || addr == 0x36) { continue; }
+        if (probe(addr, addr != 0x77) == error_t::SUCCESS) {
+            found[found_cnt++] = addr;
         }
+    }
 
+    for (uint32_t i = 0; i < found_cnt; ++i) {
         uint32_t component_id = 0;
-        memcpy(&component_id, rx_packet.payload.data, 0x04);
+        if (negotiate_speed(found[i], &component_id) != error_t::SUCCESS) {
+            continue;
+        }
         print_info("F>0x%08lx\n", component_id);
     }
     print_success("List\n");
     return error_t::SUCCESS;
 }
 
-static error_t boot_component(const uint32_t component_id) {
-    const i2c_addr_t addr = component_id_to_i2c_addr(component_id);
-    packet_t<packet_type_t::BOOT_COMMAND> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::BOOT;
-    tx_packet.payload.len = 0x60;
-    random_bytes(tx_packet.payload.data, 0x20);
+/**
+ * @brief Build a signed BOOT challenge
+ *
+ * @param challenge Copy of the challenge, kept to verify the response since
+ * the command buffer is reused for the next command
+ * @return error_t Whether the challenge was signed
+ */
+static error_t prepare_boot(uint8_t *const challenge) {
+    packet_writer_t<packet_type_t::BOOT_COMMAND> tx_packet =
+        begin_command<packet_type_t::BOOT_COMMAND>();
+    tx_packet.set_magic(packet_magic_t::BOOT);
+    tx_packet.payload().len = 0x60;
+    random_bytes(tx_packet.payload().data, 0x20);
+    memcpy(challenge, tx_packet.payload().data, 0x20);
+
+    if (sign_nonces.sign(BOOT_A_PRIV, tx_packet.payload().data, 0x20,
+                         tx_packet.payload().sig) != error_t::SUCCESS) {
+        return error_t::ERROR;
+    }
 
-    tc_sha256_state_struct sha256_ctx = {};
-    uint8_t hash[32] = {};
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+    return error_t::SUCCESS;
+}
 
-    if (uECC_sign(BOOT_A_PRIV, tx_packet.payload.data, 0x20,
-                  tx_packet.payload.sig, uECC_secp256r1()) != 1) {
+/**
+ * @brief Verify a component's response to a BOOT challenge
+ *
+ * @param component_id Component that was booted
+ * @param challenge Challenge sent to the component
+ * @param rx_packet Response from the component
+ * @return error_t Whether the component booted
+ */
+static error_t finish_boot(
+    const uint32_t component_id, const uint8_t *const challenge,
+    const packet_view_t<packet_type_t::BOOT_ACK> &rx_packet) {
+    if (rx_packet.magic() == packet_magic_t::ERROR) {
         return error_t::ERROR;
     }
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    if (!rx_packet.valid()) {
+        // Invalid packet
+        return error_t::ERROR;
+    } else if (rx_packet.payload().len != 0x40) {
+        // Invalid payload length
+        return error_t::ERROR;
+    } else if (uECC_verify_table(BOOT_C_TABLE, VERIFY_TABLE_WIDTH, challenge,
+                                 0x20, rx_packet.payload().sig,
+                                 uECC_secp256r1()) != 1) {
+        // Invalid signature
+        return error_t::ERROR;
+    }
+
+    print_info("0x%08lx>%.64s\n", component_id, rx_packet.payload().data);
+    return error_t::SUCCESS;
+}
 
-    const packet_t<packet_type_t::BOOT_ACK> rx_packet =
-        send_i2c_master_tx<packet_type_t::BOOT_ACK,
-                           packet_type_t::BOOT_COMMAND>(addr, tx_packet);
+/**
+ * @brief Boot all provisioned components
+ *
+ * The challenge for the next component is signed while the current one is
+ * being processed
+ *
+ * @return error_t Whether every component booted
+ */
+static error_t boot_components() {
+    uint8_t challenges[2][0x20] = {};
+    const uint32_t cnt = flash_status.component_cnt;
 
-    if (rx_packet.header.magic == packet_magic_t::ERROR) {
+    if (cnt == 0) { return error_t::SUCCESS; }
+    if (prepare_boot(challenges[0]) != error_t::SUCCESS) {
         return error_t::ERROR;
     }
 
-    sha256_ctx = {};
+    for (uint32_t i = 0; i < cnt; ++i) {
+        const uint32_t component_id = flash_status.component_ids[i];
+
+        const i2c_addr_t addr = component_id_to_i2c_addr(component_id);
+        start_command<packet_type_t::BOOT_ACK, packet_type_t::BOOT_COMMAND>(
+            addr);
+
+        const error_t next = i + 1 < cnt ? prepare_boot(challenges[(i + 1) % 2])
+                                         : error_t::SUCCESS;
+
+        const packet_view_t<packet_type_t::BOOT_ACK> rx_packet =
+            finish_command<packet_type_t::BOOT_ACK>(addr);
+
+        if (next != error_t::SUCCESS ||
+            finish_boot(component_id, challenges[i % 2], rx_packet) !=
+                error_t::SUCCESS) {
+            return error_t::ERROR;
+        }
+    }
+    return error_t::SUCCESS;
+}
+
+/**
+ * @brief Hash a component's response to a broadcast BOOT challenge
+ *
+ * @param data Broadcast challenge
+ * @param component_id Component that signed the response
+ * @param hash Output hash
+ */
+static void hash_broadcast_response(const uint8_t *const data,
+                                    const uint32_t component_id,
+                                    uint8_t *const hash) {
+    tc_sha256_state_struct sha256_ctx = {};
     tc_sha256_init(&sha256_ctx);
-    tc_sha256_update(&sha256_ctx, rx_packet.payload.data, 0x40);
+    tc_sha256_update(&sha256_ctx, data, 0x20);
+    tc_sha256_update(&sha256_ctx,
+                     reinterpret_cast<const uint8_t *>(&component_id),
+                     sizeof(component_id));
     tc_sha256_final(hash, &sha256_ctx);
+}
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-    if (rx_packet.header.magic != packet_magic_t::BOOT_ACK) {
-        // Invalid response
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Invalid checksum
+/**
+ * @brief Verify a component's response to a broadcast BOOT challenge
+ *
+ * @param data Random challenge that was broadcast
+ * @param component_id Component that responded
+ * @param rx_packet Response from the component
+ * @return error_t Whether the response is valid
+ */
+static error_t verify_broadcast_response(
+    const uint8_t *const data, const uint32_t component_id,
+    const packet_view_t<packet_type_t::BOOT_ACK> &rx_packet) {
+    if (rx_packet.magic() == packet_magic_t::ERROR) { return error_t::ERROR; }
+
+    uint8_t hash[32] = {};
+    hash_broadcast_response(data, component_id, hash);
+
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x40) {
+    } else if (rx_packet.payload().len != 0x40) {
         // Invalid payload length
         return error_t::ERROR;
-    } else if (uECC_verify(BOOT_C_PUB, tx_packet.payload.data, 0x20,
-                           rx_packet.payload.sig, uECC_secp256r1()) != 1) {
+    } else if (uECC_verify_table(BOOT_C_TABLE, VERIFY_TABLE_WIDTH, hash, 32,
+                                 rx_packet.payload().sig,
+                                 uECC_secp256r1()) != 1) {
         // Invalid signature
         return error_t::ERROR;
     }
+    return error_t::SUCCESS;
+}
+
+/**
+ * @brief Boot all provisioned components with one broadcast challenge
+ *
+ * The challenge lists the provisioned component IDs and is signed once. Every
+ * component verifies it in parallel, then each BOOT_ACK is collected with a
+ * chained read-only transaction
+ *
+ * @return error_t Whether every component booted
+ */
+static error_t broadcast_boot() {
+    const uint32_t cnt = flash_status.component_cnt;
+    packet_writer_t<packet_type_t::BOOT_BROADCAST> tx_packet =
+        begin_packet<packet_type_t::BOOT_BROADCAST>();
+    tx_packet.set_magic(packet_magic_t::BOOT_BROADCAST);
+    tx_packet.payload().len = sizeof(tx_packet.payload()) - 1;
+    tx_packet.payload().cnt = static_cast<uint8_t>(cnt);
+    random_bytes(tx_packet.payload().data, 0x20);
+    memcpy(tx_packet.payload().ids, flash_status.component_ids,
+           cnt * sizeof(uint32_t));
+
+    uint8_t hash[32] = {};
+    tc_sha256_state_struct sha256_ctx = {};
+    tc_sha256_init(&sha256_ctx);
+    tc_sha256_update(&sha256_ctx, tx_packet.payload().data, 0x20);
+    tc_sha256_update(&sha256_ctx, &tx_packet.payload().cnt, 1);
+    tc_sha256_update(&sha256_ctx,
+                     reinterpret_cast<const uint8_t *>(tx_packet.payload().ids),
+                     sizeof(tx_packet.payload().ids));
+    tc_sha256_final(hash, &sha256_ctx);
+
+    if (sign_nonces.sign(BOOT_A_PRIV, hash, 32, tx_packet.payload().sig) !=
+        error_t::SUCCESS) {
+        return error_t::ERROR;
+    }
+
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+
+    // The broadcast ends with a STOP so every component starts processing it
+    if (send_i2c_master_write<packet_type_t::BOOT_BROADCAST>(
+            I2C_GENERAL_CALL) != error_t::SUCCESS) {
+        return error_t::ERROR;
+    }
+
+    // Every component processes the broadcast outside its ISR, wait until all
+    // of them are done so the reads below are not interrupted by polls
+    for (uint32_t i = 0; i < cnt; ++i) {
+        if (wait_response(component_id_to_i2c_addr(
+                flash_status.component_ids[i])) != error_t::SUCCESS) {
+            return error_t::ERROR;
+        }
+    }
+
+    // Responses are collected in one bus acquisition, chaining the reads with
+    // repeated STARTs
+    for (uint32_t i = 0; i < cnt; ++i) {
+        const uint32_t component_id = flash_status.component_ids[i];
+        const bool hold = i + 1 < cnt;
+        const packet_view_t<packet_type_t::BOOT_ACK> rx_packet =
+            recv_i2c_master_read<packet_type_t::BOOT_ACK>(
+                component_id_to_i2c_addr(component_id), hold);
+
+        if (verify_broadcast_response(tx_packet.payload().data, component_id,
+                                      rx_packet) != error_t::SUCCESS) {
+            if (hold && rx_packet.magic() != packet_magic_t::ERROR) {
+                release_bus();
+            }
+            return error_t::ERROR;
+        }
 
-    print_info("0x%08lx>%.64s\n", component_id, rx_packet.payload.data);
+        print_info("0x%08lx>%.64s\n", component_id, rx_packet.payload().data);
+    }
     return error_t::SUCCESS;
 }
 
@@ -423,120 +655,118 @@ static error_t attest_component(const uint32_t component_id,
     uint8_t ctr[16] = {};
     memcpy(ctr, ATTEST_UNWRAPPED_NONCE, 16);
 
-    tc_aes_key_sched_struct aes_key = {};
-    tc_aes128_set_encrypt_key(&aes_key, unwrapped_key);
+    aes_session_t aes_session(unwrapped_key);
 
     const char *const fmts[3] = {"LOC", "DATE", "CUST"};
     uint8_t out[64] = {};
 
     for (uint8_t i = 0; i < 3; ++i) {
-        packet_t<packet_type_t::ATTEST_COMMAND> tx_packet = {};
-        tx_packet.header.magic = packet_magic_t::ATTEST;
-        tx_packet.payload.len = 0x07;
+        packet_writer_t<packet_type_t::ATTEST_COMMAND> tx_packet =
+            begin_command<packet_type_t::ATTEST_COMMAND>();
+        tx_packet.set_magic(packet_magic_t::ATTEST);
+        tx_packet.payload().len = 0x07;
 
-        memcpy(tx_packet.payload.data, "ATTEST", 0x06);
-        tx_packet.payload.data[6] = i + 1;
+        memcpy(tx_packet.payload().data, "ATTEST", 0x06);
+        tx_packet.payload().data[6] = i + 1;
 
-        uint8_t hash[32] = {};
-        tc_sha256_state_struct sha256_ctx = {};
-        tc_sha256_init(&sha256_ctx);
-        tc_sha256_update(&sha256_ctx, tx_packet.payload.data, 0x07);
-        tc_sha256_final(hash, &sha256_ctx);
+        // The commands are constant, so their signatures are made at build
+        // time
+        memcpy(tx_packet.payload().sig, ATTEST_CMD_SIGS + i * 0x40, 0x40);
 
-        if (uECC_sign(ATTEST_A_PRIV, hash, 32, tx_packet.payload.sig,
-                      uECC_secp256r1()) != 1) {
-            return error_t::ERROR;
-        }
-
-        tx_packet.header.checksum =
-            calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
-
-        const packet_t<packet_type_t::ATTEST_ACK> rx_packet =
-            send_i2c_master_tx<packet_type_t::ATTEST_ACK,
-                               packet_type_t::ATTEST_COMMAND>(addr, tx_packet);
+        tx_packet.set_checksum(
+            calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-        if (rx_packet.header.magic == packet_magic_t::ERROR) { continue; }
+        start_command<packet_type_t::ATTEST_ACK,
+                      packet_type_t::ATTEST_COMMAND>(addr);
+        const packet_view_t<packet_type_t::ATTEST_ACK> rx_packet =
+            finish_command<packet_type_t::ATTEST_ACK>(addr);
 
-        const uint32_t expected_checksum =
-            calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
+        if (rx_packet.magic() == packet_magic_t::ERROR) { continue; }
 
-        sha256_ctx = {};
+        uint8_t hash[32] = {};
+        tc_sha256_state_struct sha256_ctx = {};
         tc_sha256_init(&sha256_ctx);
-        tc_sha256_update(&sha256_ctx, rx_packet.payload.data, 64);
+        tc_sha256_update(&sha256_ctx, rx_packet.payload().data, 64);
         tc_sha256_final(hash, &sha256_ctx);
 
-        if (rx_packet.header.magic != packet_magic_t::ATTEST_ACK) {
-            // Invalid response
-            return error_t::ERROR;
-        } else if (rx_packet.header.checksum != expected_checksum) {
-            // Invalid checksum
+        if (!rx_packet.valid()) {
+            // Invalid packet
             return error_t::ERROR;
-        } else if (rx_packet.payload.len != 0x40) {
+        } else if (rx_packet.payload().len != 0x40) {
             // Invalid payload length
             return error_t::ERROR;
-        } else if (uECC_verify(ATTEST_C_PUB, hash, 32, rx_packet.payload.sig,
-                               uECC_secp256r1()) != 1) {
+        } else if (uECC_verify_table(ATTEST_C_TABLE, VERIFY_TABLE_WIDTH, hash,
+                                     32, rx_packet.payload().sig,
+                                     uECC_secp256r1()) != 1) {
             // Invalid signature
             return error_t::ERROR;
         }
 
         if (i == 0) { print_info("C>0x%08lx\n", component_id); }
 
-        tc_ctr_mode(out, 0x40, rx_packet.payload.data, 0x40, ctr, &aes_key);
+        tc_ctr_mode_session(out, 0x40, rx_packet.payload().data, 0x40, ctr,
+                            aes_session.get());
         print_info("%s>%.64s\n", fmts[i], out);
     }
 
     return error_t::SUCCESS;
 }
 
-static error_t perform_kex(const uint32_t component_id) {
-    packet_t<packet_type_t::KEX> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::KEX;
-    tx_packet.payload.len = 0x40;
-
+/**
+ * @brief Generate an ephemeral key pair and KEX packet for a component
+ *
+ * @param component_id Component to exchange keys with
+ * @return error_t Whether the key was generated
+ */
+static error_t prepare_kex(const uint32_t component_id) {
     const uint8_t index = addr_to_idx(component_id);
-    const i2c_addr_t addr = component_id_to_i2c_addr(component_id);
-
     if (index == 0xFF) { return error_t::ERROR; }
 
+    packet_writer_t<packet_type_t::KEX> tx_packet =
+        begin_command<packet_type_t::KEX>();
+
+    tx_packet.set_magic(packet_magic_t::KEX);
+    tx_packet.payload().len = 0x40;
+
     uECC_make_key(public_keys[index], private_keys[index], uECC_secp256r1());
-    memcpy(tx_packet.payload.material, public_keys[index], 0x40);
+    memcpy(tx_packet.payload().material, public_keys[index], 0x40);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+    return error_t::SUCCESS;
+}
 
-    const packet_t<packet_type_t::KEX> rx_packet =
-        send_i2c_master_tx<packet_type_t::KEX, packet_type_t::KEX>(addr,
-                                                                   tx_packet);
+/**
+ * @brief Derive the session keys from a component's KEX response
+ *
+ * @param component_id Component the keys were exchanged with
+ * @param rx_packet Response from the component
+ * @return error_t Whether the session keys were derived
+ */
+static error_t finish_kex(const uint32_t component_id,
+                          const packet_view_t<packet_type_t::KEX> &rx_packet) {
+    const uint8_t index = addr_to_idx(component_id);
 
-    if (rx_packet.header.magic == packet_magic_t::ERROR) {
+    if (index == 0xFF) { return error_t::ERROR; }
+    if (rx_packet.magic() == packet_magic_t::ERROR) {
         return error_t::ERROR;
     }
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-
-    tc_sha256_state_struct sha256_ctx = {};
-    uint8_t hash[32] = {};
-    tc_sha256_init(&sha256_ctx);
-    tc_sha256_update(&sha256_ctx, rx_packet.payload.material, 0x40);
-    tc_sha256_final(hash, &sha256_ctx);
-
-    if (rx_packet.header.magic != packet_magic_t::KEX) {
-        // Invalid response
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Invalid checksum
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x40) {
+    } else if (rx_packet.payload().len != 0x40) {
         // Invalid payload
         return error_t::ERROR;
-    } else if (uECC_valid_public_key(rx_packet.payload.material,
+    } else if (uECC_valid_public_key(rx_packet.payload().material,
                                      uECC_secp256r1()) != 0) {
         // Invalid public key
         return error_t::ERROR;
     }
-    uECC_shared_secret(rx_packet.payload.material, private_keys[index],
+
+    tc_sha256_state_struct sha256_ctx = {};
+    uint8_t hash[32] = {};
+    uECC_shared_secret(rx_packet.payload().material, private_keys[index],
                        shared_secrets[index], uECC_secp256r1());
     tc_sha256_init(&sha256_ctx);
     tc_sha256_update(&sha256_ctx, shared_secrets[index], 32);
@@ -544,7 +774,45 @@ static error_t perform_kex(const uint32_t component_id) {
 
     memcpy(ctrs[index], "\x00X\xDA\xCC\x00X\xDA\xCC", 8);
     memcpy(&ctrs[index][8], &hash[16], 0x8);
-    memcpy(aes_keys[index], hash, 16);
+    tc_aes_session_begin(&aes_sessions[index], hash);
+    return error_t::SUCCESS;
+}
+
+/**
+ * @brief Exchange session keys with all provisioned components
+ *
+ * The key pair for the next component is generated while the current
+ * exchange is being processed
+ *
+ * @return error_t Whether every key exchange succeeded
+ */
+static error_t perform_kex() {
+    const uint32_t cnt = flash_status.component_cnt;
+
+    if (cnt == 0) { return error_t::SUCCESS; }
+    tc_hmac_set_midstate(&hmac_midstate, HMAC_KEY, 32);
+    if (prepare_kex(flash_status.component_ids[0]) != error_t::SUCCESS) {
+        return error_t::ERROR;
+    }
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        const uint32_t component_id = flash_status.component_ids[i];
+
+        const i2c_addr_t addr = component_id_to_i2c_addr(component_id);
+        start_command<packet_type_t::KEX, packet_type_t::KEX>(addr);
+
+        const error_t next =
+            i + 1 < cnt ? prepare_kex(flash_status.component_ids[i + 1])
+                        : error_t::SUCCESS;
+
+        const packet_view_t<packet_type_t::KEX> rx_packet =
+            finish_command<packet_type_t::KEX>(addr);
+
+        if (next != error_t::SUCCESS ||
+            finish_kex(component_id, rx_packet) != error_t::SUCCESS) {
+            return error_t::ERROR;
+        }
+    }
     return error_t::SUCCESS;
 }
 
@@ -595,19 +863,28 @@ static error_t validate_token() {
 
 static void attempt_boot() {
     for (uint32_t i = 0; i < flash_status.component_cnt; ++i) {
-        const uint32_t component_id = flash_status.component_ids[i];
+        uint32_t listed_id = 0;
+        negotiate_speed(
+            component_id_to_i2c_addr(flash_status.component_ids[i]),
+            &listed_id);
+    }
 
-        if (perform_kex(flash_status.component_ids[i]) != error_t::SUCCESS) {
-            print_error("Error :(\n");
-            return;
-        }
-        if (boot_component(component_id) != error_t::SUCCESS) {
-            print_error("Error :(\n");
-            return;
-        }
+    if (perform_kex() != error_t::SUCCESS) {
+        print_error("Error :(\n");
+        return;
+    }
+    const error_t booted =
+        BROADCAST_BOOT &&
+                flash_status.component_cnt <= BROADCAST_MAX_COMPONENTS
+            ? broadcast_boot()
+            : boot_components();
+    if (booted != error_t::SUCCESS) {
+        print_error("Error :(\n");
+        return;
     }
     print_info("AP>%.64s\n", AP_BOOT_MSG);
     print_success("Boot\n");
+    print_i2c_trace();
 
     boot();
 }
@@ -621,9 +898,9 @@ static void attempt_replace() {
     uint32_t component_id_out = 0;
 
     recv_input("Component ID In: ", buf, sizeof(buf));
-    sscanf(buf, "%lx", &component_id_in);
+    sscanf(buf, "%" SCNx32, &component_id_in);
     recv_input("Component ID Out: ", buf, sizeof(buf));
-    sscanf(buf, "%lx", &component_id_out);
+    sscanf(buf, "%" SCNx32, &component_id_out);
 
     // Find the component to swap out
     for (uint32_t i = 0; i < flash_status.component_cnt; ++i) {
@@ -650,24 +927,25 @@ static void attempt_attest() {
 
     recv_input("Enter pin: ", pin, sizeof(pin));
 
+    // The wrapper key is the hash of the PIN ITERATIONS - 1 times and the
+    // check value the hash of it ITERATIONS times, so both are finalized from
+    // a single pass
     tc_sha256_state_struct sha256_ctx = {};
     uint8_t hash[32] = {};
     tc_sha256_init(&sha256_ctx);
-    for (uint32_t i = 0; i < ITERATIONS; ++i) {
-        tc_sha256_update(&sha256_ctx, pin, 6);
-    }
+    tc_sha256_update_repeated(&sha256_ctx, pin, 6, ITERATIONS - 1);
+    tc_sha256_state_struct wrapper_ctx = sha256_ctx;
+
+    tc_sha256_update(&sha256_ctx, pin, 6);
     tc_sha256_final(hash, &sha256_ctx);
 
     if (memcmp(hash, ATTEST_HASH, 32) != 0) {
+        wrapper_ctx = {};
         print_error("Error :(\n");
         return;
     }
 
-    tc_sha256_init(&sha256_ctx);
-    for (uint32_t i = 0; i < ITERATIONS - 1; ++i) {
-        tc_sha256_update(&sha256_ctx, pin, 6);
-    }
-    tc_sha256_final(hash, &sha256_ctx);
+    tc_sha256_final(hash, &wrapper_ctx);
 
     memcpy(wrapper_iv, ATTEST_WRAPPER_NONCE, 16);
 
@@ -675,7 +953,7 @@ static void attempt_attest() {
 
     uint32_t component_id = 0;
     recv_input("Component ID: ", buf, sizeof(buf));
-    sscanf(buf, "%lx", &component_id);
+    sscanf(buf, "%" SCNx32, &component_id);
     if (attest_component(component_id, unwrapped_key) == error_t::SUCCESS) {
         print_success("Attest\n");
     } else {
@@ -691,6 +969,13 @@ int main() {
 
     LED_On(LED3);
 
+#ifdef I2C_BENCHMARK
+    print_framing_benchmark();
+#endif
+#ifdef CRYPTO_BENCHMARK
+    print_crypto_benchmark();
+#endif
+
     // Handle commands forever
     char buf[8] = {};
     while (true) {
@@ -708,6 +993,7 @@ int main() {
         } else {
             print_error("Error :(\n");
         }
+        print_i2c_trace();
     }
 
     // Code never reaches here
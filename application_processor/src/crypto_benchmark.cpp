@@ -0,0 +1,462 @@
+/**
+ * @file crypto_benchmark.cpp
+ * @brief Cycle counts of the crypto primitives against their old versions
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#define AP 1
+#include "crypto_benchmark.h"
+
+#include "host_messaging.h"
+#include "mxc.h"
+#include "tinycrypt/aes.h"
+#include "tinycrypt/ctr_mode.h"
+#include "tinycrypt/ecc.h"
+#include "tinycrypt/ecc_dh.h"
+#include "tinycrypt/ecc_dsa.h"
+#include "tinycrypt/sha256.h"
+#include "utils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Includes from containerized build
+#include "ectf_params_secure.h"
+#include "global_secrets_secure.h"
+
+// Largest buffer the CTR benchmark encrypts
+constexpr const uint32_t CTR_MAX_LEN = 4096;
+
+// Counter blocks per engine request, as in tc_ctr_mode_session
+constexpr const uint32_t CTR_BATCH_BLOCKS = 8;
+
+alignas(4) static uint8_t plain[CTR_MAX_LEN] = {};
+alignas(4) static uint8_t expected[CTR_MAX_LEN] = {};
+alignas(4) static uint8_t actual[CTR_MAX_LEN] = {};
+
+static const uint8_t bench_key[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae,
+                                      0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88,
+                                      0x09, 0xcf, 0x4f, 0x3c};
+static const uint8_t bench_ctr[16] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5,
+                                      0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb,
+                                      0xfc, 0xfd, 0xfe, 0xff};
+
+static uint32_t cycles() { return static_cast<uint32_t>(DWT->CYCCNT); }
+
+/**
+ * @brief Median of a set of cycle counts, which an interrupt or a cache miss
+ * in a single run does not skew like it does the mean
+ *
+ * @param samples Cycle counts, sorted in place
+ * @param cnt Number of samples
+ * @return uint32_t Median cycle count
+ */
+static uint32_t median(uint32_t *const samples, const uint32_t cnt) {
+    for (uint32_t i = 1; i < cnt; ++i) {
+        const uint32_t sample = samples[i];
+        uint32_t j = i;
+        for (; j > 0 && samples[j - 1] > sample; --j) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+    return cnt % 2 != 0 ? samples[cnt / 2]
+                        : (samples[cnt / 2 - 1] + samples[cnt / 2]) / 2;
+}
+
+/**
+ * @brief CTR mode as tc_ctr_mode used to do it, setting up the engine for
+ * every block and XORing a byte at a time
+ *
+ * @param out Output
+ * @param in Input
+ * @param len Length of both
+ * @param ctr Counter, updated
+ * @param sched Key schedule
+ */
+static void byte_ctr(uint8_t *const out, const uint8_t *const in,
+                     const uint32_t len, uint8_t *const ctr,
+                     const TCAesKeySched_t sched) {
+    uint8_t buffer[16] = {};
+    uint8_t nonce[16] = {};
+    memcpy(nonce, ctr, sizeof(nonce));
+
+    uint32_t block_num = (nonce[12] << 24) | (nonce[13] << 16) |
+                         (nonce[14] << 8) | nonce[15];
+    for (uint32_t i = 0; i < len; ++i) {
+        if (i % 16 == 0) {
+            tc_aes_encrypt(buffer, nonce, sched);
+            ++block_num;
+            nonce[12] = static_cast<uint8_t>(block_num >> 24);
+            nonce[13] = static_cast<uint8_t>(block_num >> 16);
+            nonce[14] = static_cast<uint8_t>(block_num >> 8);
+            nonce[15] = static_cast<uint8_t>(block_num);
+        }
+        out[i] = buffer[i % 16] ^ in[i];
+    }
+    memcpy(&ctr[12], &nonce[12], 4);
+}
+
+/**
+ * @brief CTR mode over a session like tc_ctr_mode_session, but XORing the
+ * keystream a byte at a time
+ *
+ * Separates the cost of the byte loop from that of setting up the engine
+ *
+ * @param out Output
+ * @param in Input
+ * @param len Length of both
+ * @param ctr Counter, updated
+ * @param session Session with the key loaded
+ */
+static void session_byte_ctr(uint8_t *const out, const uint8_t *const in,
+                             const uint32_t len, uint8_t *const ctr,
+                             const TCAesSession_t session) {
+    alignas(4) uint8_t counters[CTR_BATCH_BLOCKS * 16] = {};
+    alignas(4) uint8_t buffer[CTR_BATCH_BLOCKS * 16] = {};
+    uint8_t nonce[16] = {};
+    memcpy(nonce, ctr, sizeof(nonce));
+
+    uint32_t block_num = (nonce[12] << 24) | (nonce[13] << 16) |
+                         (nonce[14] << 8) | nonce[15];
+    for (uint32_t done = 0; done < len;) {
+        uint32_t blocks = (len - done + 15) / 16;
+        if (blocks > CTR_BATCH_BLOCKS) { blocks = CTR_BATCH_BLOCKS; }
+        for (uint32_t i = 0; i < blocks; ++i) {
+            memcpy(&counters[i * 16], nonce, sizeof(nonce));
+            ++block_num;
+            nonce[12] = static_cast<uint8_t>(block_num >> 24);
+            nonce[13] = static_cast<uint8_t>(block_num >> 16);
+            nonce[14] = static_cast<uint8_t>(block_num >> 8);
+            nonce[15] = static_cast<uint8_t>(block_num);
+        }
+        tc_aes_session_encrypt(session, buffer, counters, blocks);
+
+        uint32_t batch = blocks * 16;
+        if (batch > len - done) { batch = len - done; }
+        for (uint32_t i = 0; i < batch; ++i) {
+            out[done + i] = buffer[i] ^ in[done + i];
+        }
+        done += batch;
+    }
+    memcpy(&ctr[12], &nonce[12], 4);
+}
+
+/**
+ * @brief Time the old byte loop, the byte loop over a session and the
+ * session CTR, copying and in place
+ *
+ */
+static void print_ctr_benchmark() {
+    tc_aes_key_sched_struct sched = {};
+    tc_aes128_set_encrypt_key(&sched, bench_key);
+    aes_session_t session(bench_key);
+
+    for (uint32_t i = 0; i < CTR_MAX_LEN; ++i) {
+        plain[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    for (uint32_t len = 16; len <= CTR_MAX_LEN; len *= 4) {
+        uint8_t ctr[16] = {};
+
+        memcpy(ctr, bench_ctr, sizeof(ctr));
+        uint32_t start = cycles();
+        byte_ctr(expected, plain, len, ctr, &sched);
+        const uint32_t byte_cycles = cycles() - start;
+
+        memcpy(ctr, bench_ctr, sizeof(ctr));
+        start = cycles();
+        session_byte_ctr(actual, plain, len, ctr, session.get());
+        const uint32_t session_byte_cycles = cycles() - start;
+        bool match = memcmp(actual, expected, len) == 0;
+
+        memcpy(ctr, bench_ctr, sizeof(ctr));
+        start = cycles();
+        tc_ctr_mode_session(actual, len, plain, len, ctr, session.get());
+        const uint32_t word_cycles = cycles() - start;
+        match = match && memcmp(actual, expected, len) == 0;
+
+        memcpy(actual, plain, len);
+        memcpy(ctr, bench_ctr, sizeof(ctr));
+        start = cycles();
+        tc_ctr_mode_session(actual, len, actual, len, ctr, session.get());
+        const uint32_t in_place_cycles = cycles() - start;
+        match = match && memcmp(actual, expected, len) == 0;
+
+        print_debug("CTR %4lu B: byte %lu, session byte %lu, word %lu, "
+                    "in place %lu cycles%s\n",
+                    len, byte_cycles, session_byte_cycles, word_cycles,
+                    in_place_cycles, match ? "" : ", MISMATCH");
+    }
+}
+
+/**
+ * @brief Time stretching a PIN with one update per copy against
+ * tc_sha256_update_repeated
+ *
+ */
+static void print_pin_benchmark() {
+    const uint8_t pin[6] = {'1', '2', '3', '4', '5', '6'};
+    uint8_t expected_hash[32] = {};
+    uint8_t actual_hash[32] = {};
+    tc_sha256_state_struct sha256_ctx = {};
+
+    uint32_t start = cycles();
+    tc_sha256_init(&sha256_ctx);
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        tc_sha256_update(&sha256_ctx, pin, sizeof(pin));
+    }
+    tc_sha256_final(expected_hash, &sha256_ctx);
+    const uint32_t generic_cycles = cycles() - start;
+
+    start = cycles();
+    tc_sha256_init(&sha256_ctx);
+    tc_sha256_update_repeated(&sha256_ctx, pin, sizeof(pin), ITERATIONS);
+    tc_sha256_final(actual_hash, &sha256_ctx);
+    const uint32_t repeated_cycles = cycles() - start;
+
+    print_debug("PIN x%lu: update %lu, repeated %lu cycles%s\n", ITERATIONS,
+                generic_cycles, repeated_cycles,
+                memcmp(actual_hash, expected_hash, 32) == 0 ? ""
+                                                            : ", MISMATCH");
+}
+
+/**
+ * @brief Time key generation and signing, which multiply by the generator
+ * with the uECC_COMB_WIDTH comb, against the Montgomery ladder k.G they used
+ *
+ * Rebuild with -DuECC_COMB_WIDTH=N to compare table sizes, the medians of
+ * several runs are printed
+ *
+ */
+static void print_ecc_benchmark() {
+    constexpr const uint32_t runs = 15;
+    constexpr const uint32_t table_bytes =
+        uECC_COMB_WIDTH != 0 ? 32u << uECC_COMB_WIDTH : 0;
+    const uECC_Curve curve = uECC_secp256r1();
+    const uint8_t hash[32] = {};
+    uint8_t public_key[64] = {};
+    uint8_t private_key[32] = {};
+    uint8_t signature[64] = {};
+    uECC_word_t scalar[NUM_ECC_WORDS] = {};
+    uECC_word_t regularized[2][NUM_ECC_WORDS] = {};
+    uECC_word_t point[NUM_ECC_WORDS * 2] = {};
+    uint32_t keygen_cycles[runs] = {};
+    uint32_t sign_cycles[runs] = {};
+    uint32_t ladder_cycles[runs] = {};
+    bool match = true;
+
+    for (uint32_t i = 0; i < runs; ++i) {
+        uint32_t start = cycles();
+        uECC_make_key(public_key, private_key, curve);
+        keygen_cycles[i] = cycles() - start;
+
+        start = cycles();
+        uECC_sign(private_key, hash, sizeof(hash), signature, curve);
+        sign_cycles[i] = cycles() - start;
+        match = match && uECC_verify(public_key, hash, sizeof(hash), signature,
+                                     curve) == 1;
+
+        uECC_vli_bytesToNative(scalar, private_key, sizeof(private_key));
+        start = cycles();
+        const uECC_word_t carry =
+            regularize_k(scalar, regularized[0], regularized[1], curve);
+        EccPoint_mult(point, curve->G, regularized[!carry], nullptr,
+                      curve->num_n_bits + 1, curve);
+        ladder_cycles[i] = cycles() - start;
+
+        uint8_t ladder_key[64] = {};
+        uECC_vli_nativeToBytes(ladder_key, 32, point);
+        uECC_vli_nativeToBytes(&ladder_key[32], 32, &point[NUM_ECC_WORDS]);
+        match = match && memcmp(ladder_key, public_key, 64) == 0;
+    }
+
+    print_debug("ECC comb width %d, %lu B: keygen %lu, sign %lu, ladder k.G "
+                "%lu cycles%s\n",
+                uECC_COMB_WIDTH, table_bytes, median(keygen_cycles, runs),
+                median(sign_cycles, runs), median(ladder_cycles, runs),
+                match ? "" : ", MISMATCH");
+}
+
+/**
+ * @brief u1.G + u2.Q one bit of both scalars at a time with Shamir's trick, as
+ * uECC_verify used to compute it
+ *
+ * @param result Output, affine
+ * @param u1 Scalar of G, nonzero
+ * @param u2 Scalar of Q, nonzero
+ * @param point Q
+ * @param curve Curve
+ */
+static void shamir_mult(uECC_word_t *const result, const uECC_word_t *const u1,
+                        const uECC_word_t *const u2,
+                        const uECC_word_t *const point,
+                        const uECC_Curve curve) {
+    uECC_word_t sum[NUM_ECC_WORDS * 2] = {};
+    uECC_word_t tx[NUM_ECC_WORDS] = {};
+    uECC_word_t ty[NUM_ECC_WORDS] = {};
+    uECC_word_t tz[NUM_ECC_WORDS] = {};
+    uECC_word_t z[NUM_ECC_WORDS] = {};
+    uECC_word_t *const rx = result;
+    uECC_word_t *const ry = &result[NUM_ECC_WORDS];
+
+    // sum = G + Q
+    uECC_vli_set(sum, point, NUM_ECC_WORDS * 2);
+    uECC_vli_set(tx, curve->G, NUM_ECC_WORDS);
+    uECC_vli_set(ty, &curve->G[NUM_ECC_WORDS], NUM_ECC_WORDS);
+    uECC_vli_modSub(z, sum, tx, curve->p, NUM_ECC_WORDS);
+    XYcZ_add(tx, ty, sum, &sum[NUM_ECC_WORDS], curve);
+    uECC_vli_modInv(z, z, curve->p, NUM_ECC_WORDS);
+    apply_z(sum, &sum[NUM_ECC_WORDS], z, curve);
+
+    const uECC_word_t *const points[4] = {nullptr, curve->G, point, sum};
+    const auto select = [&](const bitcount_t bit) {
+        return points[(uECC_vli_testBit(u1, bit) != 0 ? 1 : 0) |
+                      (uECC_vli_testBit(u2, bit) != 0 ? 2 : 0)];
+    };
+    const bitcount_t u1_bits = uECC_vli_numBits(u1, NUM_ECC_WORDS);
+    const bitcount_t u2_bits = uECC_vli_numBits(u2, NUM_ECC_WORDS);
+    const bitcount_t num_bits = u1_bits > u2_bits ? u1_bits : u2_bits;
+
+    const uECC_word_t *selected = select(num_bits - 1);
+    uECC_vli_set(rx, selected, NUM_ECC_WORDS);
+    uECC_vli_set(ry, &selected[NUM_ECC_WORDS], NUM_ECC_WORDS);
+    uECC_vli_clear(z, NUM_ECC_WORDS);
+    z[0] = 1;
+
+    for (bitcount_t i = num_bits - 2; i >= 0; --i) {
+        curve->double_jacobian(rx, ry, z, curve);
+        selected = select(i);
+        if (selected == nullptr) { continue; }
+
+        uECC_vli_set(tx, selected, NUM_ECC_WORDS);
+        uECC_vli_set(ty, &selected[NUM_ECC_WORDS], NUM_ECC_WORDS);
+        apply_z(tx, ty, z, curve);
+        uECC_vli_modSub(tz, rx, tx, curve->p, NUM_ECC_WORDS);
+        XYcZ_add(tx, ty, rx, ry, curve);
+        uECC_vli_modMult_fast(z, z, tz, curve);
+    }
+
+    uECC_vli_modInv(z, z, curve->p, NUM_ECC_WORDS);
+    apply_z(rx, ry, z, curve);
+}
+
+/**
+ * @brief Time u1.G + u2.Q for BOOT_C_PUB with Shamir's trick against the wNAF
+ * engine of uECC_verify, then verifying with uECC_verify against the
+ * build-time comb table
+ *
+ * The AP cannot sign as the component, so the signature is arbitrary and
+ * both reject it, after the same work as an accepted one
+ *
+ */
+static void print_verify_benchmark() {
+    constexpr const uint32_t runs = 4;
+    const uECC_Curve curve = uECC_secp256r1();
+    const uint8_t hash[32] = {1};
+    uint8_t signature[64] = {};
+    uECC_word_t point[NUM_ECC_WORDS * 2] = {};
+    uECC_word_t u1[NUM_ECC_WORDS] = {};
+    uECC_word_t u2[NUM_ECC_WORDS] = {};
+    uECC_word_t expected_sum[NUM_ECC_WORDS * 2] = {};
+    uECC_word_t actual_sum[NUM_ECC_WORDS * 2] = {};
+    uint32_t shamir_cycles = 0;
+    uint32_t wnaf_cycles = 0;
+    bool match = true;
+
+    uECC_vli_bytesToNative(point, BOOT_C_PUB, 32);
+    uECC_vli_bytesToNative(&point[NUM_ECC_WORDS], &BOOT_C_PUB[32], 32);
+    for (uint32_t i = 0; i < runs; ++i) {
+        match = match &&
+                uECC_generate_random_int(u1, curve->n, NUM_ECC_WORDS) &&
+                uECC_generate_random_int(u2, curve->n, NUM_ECC_WORDS);
+
+        uint32_t start = cycles();
+        shamir_mult(expected_sum, u1, u2, point, curve);
+        shamir_cycles += cycles() - start;
+
+        start = cycles();
+        EccPoint_mult_twin_wnaf(actual_sum, u1, u2, point, curve);
+        wnaf_cycles += cycles() - start;
+        match = match &&
+                memcmp(actual_sum, expected_sum, sizeof(actual_sum)) == 0;
+    }
+
+    print_debug("u1.G + u2.Q: Shamir %lu, wNAF %lu cycles%s\n",
+                shamir_cycles / runs, wnaf_cycles / runs,
+                match ? "" : ", MISMATCH");
+
+    memset(signature, 0x5A, sizeof(signature));
+    uint32_t start = cycles();
+    const int wnaf_result =
+        uECC_verify(BOOT_C_PUB, hash, sizeof(hash), signature, curve);
+    const uint32_t verify_cycles = cycles() - start;
+
+    start = cycles();
+    const int table_result =
+        uECC_verify_table(BOOT_C_TABLE, VERIFY_TABLE_WIDTH, hash, sizeof(hash),
+                          signature, curve);
+    const uint32_t table_cycles = cycles() - start;
+
+    print_debug("Verify: wNAF %lu, width %u table %lu cycles%s\n",
+                verify_cycles, VERIFY_TABLE_WIDTH, table_cycles,
+                wnaf_result == table_result ? "" : ", MISMATCH");
+}
+
+/**
+ * @brief Time signing, verifying and ECDH, nearly all of which is field
+ * multiplication and squaring
+ *
+ */
+static void print_field_benchmark() {
+    constexpr const uint32_t runs = 4;
+    const uECC_Curve curve = uECC_secp256r1();
+    const uint8_t hash[32] = {2};
+    uint8_t public_key[2][64] = {};
+    uint8_t private_key[2][32] = {};
+    uint8_t signature[64] = {};
+    uint8_t secret[2][32] = {};
+    uint32_t sign_cycles = 0;
+    uint32_t verify_cycles = 0;
+    uint32_t ecdh_cycles = 0;
+    bool match = true;
+
+    for (uint32_t i = 0; i < runs; ++i) {
+        match = match && uECC_make_key(public_key[0], private_key[0], curve) &&
+                uECC_make_key(public_key[1], private_key[1], curve);
+
+        uint32_t start = cycles();
+        uECC_sign(private_key[0], hash, sizeof(hash), signature, curve);
+        sign_cycles += cycles() - start;
+
+        start = cycles();
+        match = match && uECC_verify(public_key[0], hash, sizeof(hash),
+                                     signature, curve) == 1;
+        verify_cycles += cycles() - start;
+
+        start = cycles();
+        uECC_shared_secret(public_key[1], private_key[0], secret[0], curve);
+        ecdh_cycles += cycles() - start;
+
+        uECC_shared_secret(public_key[0], private_key[1], secret[1], curve);
+        match = match && memcmp(secret[0], secret[1], sizeof(secret[0])) == 0;
+    }
+
+    print_debug("Field: sign %lu, verify %lu, ECDH %lu cycles%s\n",
+                sign_cycles / runs, verify_cycles / runs, ecdh_cycles / runs,
+                match ? "" : ", MISMATCH");
+}
+
+void print_crypto_benchmark() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    print_debug("Crypto benchmark at %luHz\n", SystemCoreClock);
+    print_ctr_benchmark();
+    print_pin_benchmark();
+    print_ecc_benchmark();
+    print_verify_benchmark();
+    print_field_benchmark();
+}
@@ -10,9 +10,27 @@
  */
 #include "host_messaging.h"
 
+#include "board.h"
+#include "uart.h"
+
+static bool (*idle_task)() = nullptr;
+
+/**
+ * @brief Runs the idle task until the host starts sending or it is done
+ *
+ */
+static void idle_until_input() {
+    if (idle_task == nullptr) { return; }
+    mxc_uart_regs_t *const uart = MXC_UART_GET_UART(CONSOLE_UART);
+    while (MXC_UART_GetRXFIFOAvailable(uart) == 0 && idle_task()) {}
+}
+
+void set_input_idle_task(bool (*const task)()) { idle_task = task; }
+
 void recv_input(const char *const msg, char *const buf, const size_t buflen) {
     print_debug("%s", msg);
     print_ack();
+    idle_until_input();
     size_t i = 0;
     int ch = 0;
     do {
@@ -28,6 +46,7 @@ void recv_input(const char *const msg, uint8_t *const buf,
                 const size_t buflen) {
     print_debug("%s", msg);
     print_ack();
+    idle_until_input();
     size_t i = 0;
     int ch = 0;
     do {
@@ -10,12 +10,85 @@
  */
 #include "simple_i2c_controller.h"
 
+#include "dma.h"
 #include "errors.h"
+#include "host_messaging.h"
 #include "i2c.h"
+#include "i2c_trace.h"
 #include "mxc.h"
+#include "mxc_delay.h"
 #include "packets.h"
 
 namespace i2c {
+    uint8_t txbuf[I2C_FIXED_FRAME] = {};
+    uint8_t rxbuf[I2C_FIXED_FRAME] = {};
+
+    static i2c_speed_t speeds[0x80] = {};
+    static i2c_speed_t current_speed = i2c_speed_t::STANDARD;
+
+    /**
+     * @brief Cycle statistics of the phases of an exchange
+     *
+     */
+    struct trace_phases_t {
+        trace_stat_t setup;
+        trace_stat_t address;
+        trace_stat_t stretch;
+        trace_stat_t data;
+        trace_stat_t total;
+    };
+
+    static trace_phases_t trace_stats[TRACE_TYPES] = {};
+
+    static inline trace_point_t trace_begin(const packet_type_t type) {
+        return {type, trace_cycles(), 0};
+    }
+
+    static inline void trace_issue(trace_point_t &trace) {
+        trace.issued = trace_cycles();
+    }
+
+    /**
+     * @brief Split a completed exchange into its phases and record them
+     *
+     * @param trace Timestamps taken when the exchange was started
+     * @param tx_len Bytes written
+     * @param rx_len Bytes read
+     * @param hold Whether the exchange ended without a STOP
+     */
+    static void trace_end(const trace_point_t &trace, const uint32_t tx_len,
+                          const uint32_t rx_len, const bool hold) {
+        if (!I2C_TRACE_ENABLED) { return; }
+        const uint32_t end = trace_cycles();
+        const uint32_t freq = speed_to_freq(current_speed);
+
+        // START or repeated START and the address byte of each direction
+        const uint32_t addr_phases =
+            (tx_len != 0 || rx_len == 0 ? 1 : 0) + (rx_len != 0 ? 1 : 0);
+        const uint32_t address = scl_to_core_cycles(addr_phases * 10, freq);
+        const uint32_t data =
+            scl_to_core_cycles(9 * (tx_len + rx_len) + (hold ? 0 : 1), freq);
+        const uint32_t bus = end - trace.issued;
+
+        trace_phases_t &stats = trace_stats[trace_index(trace.type)];
+        stats.setup.add(trace.issued - trace.start);
+        stats.address.add(address);
+        stats.stretch.add(bus > address + data ? bus - address - data : 0);
+        stats.data.add(data);
+        stats.total.add(end - trace.start);
+    }
+
+    static void dma_isr() { MXC_DMA_Handler(); }
+
+    static void async_complete(mxc_i2c_req_t *req, int result) {
+        async_state_t *const state = reinterpret_cast<async_state_t *>(req);
+        if (result == E_NO_ERROR) {
+            trace_end(state->trace, req->tx_len, req->rx_len, false);
+        }
+        state->error = result;
+        state->done = true;
+    }
+
     error_t i2c_simple_controller_init() {
         // Initialize the I2C Interface
         const int error = MXC_I2C_Init(MXC_I2C1, true, 0);
@@ -25,6 +98,196 @@ namespace i2c {
         }
 
         MXC_I2C_SetFrequency(MXC_I2C1, I2C_FREQ);
+        trace_init();
+
+        // Initialize DMA for asynchronous transactions
+        if (I2C_DEFERRED_PROCESSING) { return error_t::SUCCESS; }
+        if (MXC_DMA_Init() != E_NO_ERROR) {
+            printf("Failed to initialize DMA.\n");
+            return error_t::ERROR;
+        }
+        for (uint8_t ch = 0; ch < MXC_DMA_CHANNELS; ++ch) {
+            MXC_NVIC_SetVector(MXC_DMA_CH_GET_IRQ(ch), dma_isr);
+            NVIC_EnableIRQ(MXC_DMA_CH_GET_IRQ(ch));
+        }
+        return error_t::SUCCESS;
+    }
+
+    error_t probe(const i2c_addr_t addr, const bool hold) {
+        mxc_i2c_req_t request;
+        request.i2c = MXC_I2C1;
+        request.addr = addr;
+        request.tx_len = 0;
+        request.tx_buf = nullptr;
+        request.rx_len = 0;
+        request.rx_buf = nullptr;
+        request.restart = hold ? 1 : 0;
+        request.callback = nullptr;
+
+        select_speed(addr);
+
+        return MXC_I2C_MasterTransaction(&request) == E_NO_ERROR
+                   ? error_t::SUCCESS
+                   : error_t::ERROR;
+    }
+
+    void release_bus() { MXC_I2C_Stop(MXC_I2C1); }
+
+    error_t transfer(const i2c_addr_t addr, const packet_type_t type,
+                     const uint32_t tx_len, const uint32_t rx_len,
+                     const bool hold) {
+        mxc_i2c_req_t request;
+        request.i2c = MXC_I2C1;
+        request.addr = addr;
+        request.tx_len = tx_len;
+        request.tx_buf = tx_len != 0 ? txbuf : nullptr;
+        request.rx_len = rx_len;
+        request.rx_buf = rx_len != 0 ? rxbuf : nullptr;
+        request.restart = hold ? 1 : 0;
+        request.callback = nullptr;
+
+        trace_point_t trace = trace_begin(type);
+        select_speed(addr);
+        trace_issue(trace);
+
+        if (MXC_I2C_MasterTransaction(&request) != E_NO_ERROR) {
+            // Fall back to standard mode if the faster clock failed
+            set_speed(addr, i2c_speed_t::STANDARD);
+            rxbuf[magic_offset] = static_cast<uint8_t>(packet_magic_t::ERROR);
+            if (hold) { release_bus(); }
+            return error_t::ERROR;
+        }
+        trace_end(trace, tx_len, rx_len, hold);
+        return error_t::SUCCESS;
+    }
+
+    error_t start_async(async_state_t &state, const i2c_addr_t addr,
+                        const packet_type_t type, const uint32_t tx_len,
+                        const uint32_t rx_len) {
+        state.done = false;
+        state.error = E_NO_ERROR;
+
+        state.request.i2c = MXC_I2C1;
+        state.request.addr = addr;
+        state.request.tx_len = tx_len;
+        state.request.tx_buf = state.txbufs[state.next];
+        state.request.rx_len = rx_len;
+        state.request.rx_buf = state.rxbuf;
+        state.request.restart = 0;
+        state.request.callback = async_complete;
+        state.next ^= 1;
+
+        state.trace = trace_begin(type);
+        select_speed(addr);
+        trace_issue(state.trace);
+
+        const int error = MXC_I2C_MasterTransactionDMA(&state.request);
+        if (error != E_NO_ERROR) {
+            state.error = error;
+            state.done = true;
+            return error_t::ERROR;
+        }
         return error_t::SUCCESS;
     }
+
+    int wait_async(async_state_t &state) {
+        while (!state.done) { continue; }
+        if (state.error != E_NO_ERROR) {
+            // Fall back to standard mode if the faster clock failed
+            set_speed(state.request.addr, i2c_speed_t::STANDARD);
+        }
+        return state.error;
+    }
+
+    error_t wait_response(const i2c_addr_t addr) {
+        for (uint32_t i = 0; i < I2C_POLL_LIMIT; ++i) {
+            if (transfer(addr, packet_type_t::BUSY, 0, 1) != error_t::SUCCESS) {
+                return error_t::ERROR;
+            }
+            if (rxbuf[magic_offset] !=
+                static_cast<uint8_t>(packet_magic_t::BUSY)) {
+                return error_t::SUCCESS;
+            }
+            MXC_Delay(I2C_POLL_INTERVAL_US);
+        }
+        return error_t::ERROR;
+    }
+
+    void set_speed(const i2c_addr_t addr, const i2c_speed_t speed) {
+        if (addr >= sizeof(speeds)) { return; }
+        speeds[addr] = speed > I2C_MAX_SPEED ? I2C_MAX_SPEED : speed;
+    }
+
+    i2c_speed_t get_speed(const i2c_addr_t addr) {
+        if (addr >= sizeof(speeds)) { return i2c_speed_t::STANDARD; }
+        return speeds[addr];
+    }
+
+    void select_speed(const i2c_addr_t addr) {
+        const i2c_speed_t speed = get_speed(addr);
+        if (speed == current_speed) { return; }
+        MXC_I2C_SetFrequency(MXC_I2C1, speed_to_freq(speed));
+        current_speed = speed;
+    }
+
+    template<packet_type_t R, packet_type_t T>
+    static void print_exchange_time(const char *const name) {
+        const uint32_t fixed =
+            bus_time_us(wire_len<T>(false), wire_len<R>(false));
+        const uint32_t framed =
+            bus_time_us(wire_len<T>(true), wire_len<R>(true));
+        print_debug("%s: %lu/%lu bytes, fixed %luus, framed %luus\n", name,
+                    wire_len<T>(true), wire_len<R>(true), fixed, framed);
+    }
+
+    void print_framing_benchmark() {
+        print_exchange_time<packet_type_t::KEX, packet_type_t::KEX>("KEX");
+        print_exchange_time<packet_type_t::LIST_ACK,
+                            packet_type_t::LIST_COMMAND>("LIST");
+        print_exchange_time<packet_type_t::ATTEST_ACK,
+                            packet_type_t::ATTEST_COMMAND>("ATTEST");
+        print_exchange_time<packet_type_t::BOOT_ACK,
+                            packet_type_t::BOOT_COMMAND>("BOOT");
+        print_exchange_time<packet_type_t::SECURE, packet_type_t::SECURE>(
+            "SECURE");
+        print_exchange_time<packet_type_t::SECURE, packet_type_t::SECURE_REQ>(
+            "SECURE_REQ");
+        print_debug("BOOT_BROADCAST: %lu bytes, fixed %luus, framed %luus\n",
+                    wire_len<packet_type_t::BOOT_BROADCAST>(true),
+                    bus_time_us(I2C_FIXED_FRAME, 0),
+                    bus_time_us(wire_len<packet_type_t::BOOT_BROADCAST>(true),
+                                0));
+    }
+
+    /**
+     * @brief Print the statistics of one phase
+     *
+     * @param type Packet type
+     * @param phase Name of the phase
+     * @param stat Statistics of the phase
+     */
+    static void print_trace_stat(const packet_type_t type,
+                                 const char *const phase,
+                                 const trace_stat_t &stat) {
+        print_debug("%s %s: %lu/%lu/%lu\n", trace_name(type), phase, stat.min,
+                    stat.avg(), stat.max);
+    }
+
+    void print_i2c_trace() {
+        if (!I2C_TRACE_ENABLED) { return; }
+        print_debug("I2C trace, min/avg/max cycles at %luHz\n",
+                    SystemCoreClock);
+        for (uint32_t i = 0; i < TRACE_TYPES; ++i) {
+            const packet_type_t type = static_cast<packet_type_t>(i);
+            const trace_phases_t &stats = trace_stats[i];
+            if (stats.total.count == 0) { continue; }
+            print_debug("%s: %lu exchanges\n", trace_name(type),
+                        stats.total.count);
+            print_trace_stat(type, "setup", stats.setup);
+            print_trace_stat(type, "address", stats.address);
+            print_trace_stat(type, "stretch", stats.stretch);
+            print_trace_stat(type, "data", stats.data);
+            print_trace_stat(type, "total", stats.total);
+        }
+    }
 }  // namespace i2c
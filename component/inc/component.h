@@ -15,6 +15,13 @@
 
 #include <stdint.h>
 
+// Secure messages each direction can hold before the sender has to wait,
+// a power of two
+constexpr const uint32_t SECURE_QUEUE_DEPTH = 4;
+
+// Signing nonces precomputed while idle, one per signature a boot makes
+constexpr const uint32_t NONCE_POOL_DEPTH = 1;
+
 enum class bootstate_t { PREBOOT, POSTBOST };
 
 /**
@@ -41,6 +48,14 @@ error_t process_attest(const uint8_t *const data);
  */
 error_t process_boot(const uint8_t *const data);
 
+/**
+ * @brief Process the broadcast boot command
+ *
+ * @param data Data received from the I2C ISR
+ * @return Whether the command was processed successfully
+ */
+error_t process_boot_broadcast(const uint8_t *const data);
+
 /**
  * @brief Process the ecc key exchange command
  *
@@ -85,11 +100,14 @@ error_t process_secure_receive(const uint8_t *const data);
  * @brief Secure Send
  *
  * @param buffer: uint8_t*, pointer to data to be send
- * @param len: uint8_t, size of data to be sent
+ * @param len: uint8_t, size of data to be sent, at most 64
  *
  * Securely send data over I2C. This function is utilized in POST_BOOT
  * functionality. This function must be implemented by your team to align
  * with the security requirements.
+ *
+ * Returns once the message is queued, waiting only while the queue is full.
+ * The AP pulls queued messages one per secure receive
  */
 void secure_send(const uint8_t *const buffer, const uint8_t len);
 
@@ -103,6 +121,8 @@ void secure_send(const uint8_t *const buffer, const uint8_t len);
  * Securely receive data over I2C. This function is utilized in POST_BOOT
  * functionality. This function must be implemented by your team to align
  * with the security requirements.
+ *
+ * Takes the oldest message the AP queued, waiting while there is none
  */
 int secure_receive(uint8_t *const buffer);
 
@@ -0,0 +1,77 @@
+/**
+ * @file events.h
+ * @brief Work items signalled from interrupts to the component's main loop
+ * @version 0.1
+ *
+ * ISRs mark work as pending and execute SEV, the main loop sleeps in WFE until
+ * something it waits for is pending. A SEV between the check and the WFE
+ * leaves the event register set so the wake-up is never lost
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef EVENTS
+#define EVENTS
+
+#include <stdint.h>
+
+namespace events {
+    /**
+     * @brief Work items, combined as a mask when waiting
+     *
+     */
+    enum class event_t : uint32_t {
+        COMMAND = 1U << 0,  // Command queued for process_deferred
+        BOOT = 1U << 1,     // Boot state changed
+        SECURE = 1U << 2,   // Secure channel buffer filled or drained
+    };
+
+    constexpr uint32_t operator|(const event_t a, const event_t b) {
+        return static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+    }
+
+    /**
+     * @brief Mark a work item as pending and wake the main loop
+     *
+     * Safe to call from interrupt context
+     *
+     * @param event Work item
+     */
+    void signal(event_t event);
+
+    /**
+     * @brief Check for pending work items without sleeping or clearing them
+     *
+     * @param mask Mask of event_t values
+     * @return bool Whether any of them is pending
+     */
+    bool pending(uint32_t mask);
+
+    /**
+     * @brief Sleep until any of the given work items is pending
+     *
+     * @param mask Mask of event_t values
+     * @return uint32_t The pending items of the mask, now cleared
+     */
+    uint32_t wait(uint32_t mask);
+
+    /**
+     * @brief Sleep until a work item is pending
+     *
+     * @param event Work item
+     */
+    inline void wait(const event_t event) {
+        wait(static_cast<uint32_t>(event));
+    }
+
+    /**
+     * @brief Print min/avg/max cycles from a signal to the main loop running
+     *
+     * Only wake-ups from sleep are counted. Measured with the I2C trace
+     * cycle counter, so nothing is printed without -DI2C_TRACE
+     *
+     */
+    void print_wake_latency();
+}  // namespace events
+
+#endif /* EVENTS */
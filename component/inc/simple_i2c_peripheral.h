@@ -14,17 +14,49 @@
 
 #include "errors.h"
 #include "i2c.h"
+#include "i2c_trace.h"
 #include "mxc.h"
 #include "packets.h"
 
 #include <stdint.h>
 
 namespace i2c {
-    constexpr const uint32_t I2C_FREQ = 100000;
+    // Fastest bus speed the component can keep up with
+    constexpr const i2c_speed_t I2C_MAX_SPEED = i2c_speed_t::FAST_PLUS;
+
+    // I2C frequency in HZ, timing is configured for the fastest speed
+    constexpr const uint32_t I2C_FREQ = speed_to_freq(I2C_MAX_SPEED);
+
+    // Stop TX/RX at the real frame length instead of the full buffer
+    constexpr const bool I2C_LENGTH_FRAMING = true;
+
+    // Process commands in the main loop instead of the ISR, answering reads
+    // with BUSY until the response is done. Only the post-boot secure channel
+    // is still answered within a write/read exchange
+    constexpr const bool I2C_DEFERRED_PROCESSING = true;
+
+    // Move frames between the FIFOs and the buffers with DMA so the ISR only
+    // runs on address matches and STOPs. Only checked against the sim's DMA
+    // model so far, off until it has been validated on the board
+    constexpr const bool I2C_PERIPHERAL_DMA = false;
 
     using i2c_addr_t = uint8_t;
     using i2c_cb_t = error_t (*)(const uint8_t *const);
 
+    /**
+     * @brief State of a command processed by the main loop
+     *
+     * A command written while another one is QUEUED is rejected: it is
+     * dropped, the response to the queued command is discarded and reads are
+     * answered with ERROR until the next command is accepted. The controller
+     * never receives one command's response as the reply to another
+     */
+    enum class command_state_t : uint8_t {
+        IDLE,    // No command outstanding
+        QUEUED,  // Waiting for the main loop, reads are answered with BUSY
+        READY    // Response is in the TX buffer until the next command
+    };
+
     /**
      * @brief ISR for the I2C Peripheral
      *
@@ -42,6 +74,24 @@ namespace i2c {
      */
     error_t i2c_simple_peripheral_init(uint8_t addr, i2c_cb_t cb);
 
+    /**
+     * @brief Process a queued command outside the ISR
+     *
+     * Must be called from the main loop when deferred processing is enabled.
+     * The bus is free for other components while the command is processed
+     */
+    void process_deferred();
+
+    /**
+     * @brief Print min/avg/max cycles of every traced exchange per packet type
+     *
+     * Exchanges are keyed by the command received, or by the response for a
+     * read of a response prepared earlier. The callback phase is the time the
+     * controller sees the clock stretched for
+     *
+     */
+    void print_i2c_trace();
+
     /**
      * @brief Convert 4-byte component ID to I2C address
      *
@@ -55,25 +105,65 @@ namespace i2c {
 
     static constexpr const uint32_t bufsize = 256;
 
-    extern volatile uint8_t txbuf[bufsize];
-    extern volatile uint8_t rxbuf[bufsize];
+    // Response the ISR is sending, never written through
+    extern const volatile uint8_t *volatile txbuf;
+    // Buffer the ISR is receiving the current command into
+    extern volatile uint8_t *volatile rxbuf;
     extern volatile uint32_t rxcnt;
     extern volatile uint32_t txcnt;
+    extern volatile uint32_t rxlen;
+    extern volatile uint32_t txlen;
     extern volatile i2c_cb_t processing_cb;
+    extern volatile bool general_call;
+    extern volatile command_state_t command_state;
+
+    /**
+     * @brief Zero the used bytes of a buffer with word stores
+     *
+     * @param buf Word aligned buffer with room rounded up to a whole word
+     * @param len Number of bytes that may be nonzero
+     */
+    inline void scrub(volatile uint8_t *const buf, const uint32_t len) {
+        volatile uint32_t *const words =
+            reinterpret_cast<volatile uint32_t *>(buf);
+        for (uint32_t i = 0; i < (len + 3) / 4; ++i) { words[i] = 0; }
+    }
+
+    /**
+     * @brief Take the TX buffer the ISR is not sending to build a response in
+     *
+     * Only the bytes left over by the last response built in it are scrubbed
+     *
+     * @param len Length of the response
+     * @return uint8_t* Zeroed buffer of at least len bytes
+     */
+    uint8_t *acquire_tx_buffer(uint32_t len);
+
+    /**
+     * @brief Swap the response built with acquire_tx_buffer in for sending
+     *
+     * @param len Length of the response
+     */
+    void publish_tx_buffer(uint32_t len);
+
+    /**
+     * @brief Start building a packet in place in the TX buffer
+     *
+     * @tparam T The packet type
+     * @return packet_writer_t<T> Writer over the TX buffer
+     */
+    template<packet_type_t T> packet_writer_t<T> begin_packet() {
+        return packet_writer_t<T>(acquire_tx_buffer(frame_size<T>()));
+    }
 
     /**
-     * @brief Set the raw TX buffer to a packet
+     * @brief Mark the packet built in the TX buffer as ready to send
      *
      * @tparam T The packet type
-     * @param packet The packet to send
+     * @param packet Packet built with begin_packet
      */
-    template<packet_type_t T> void send_packet(packet_t<T> packet) {
-        txbuf[0] = static_cast<uint8_t>(packet.header.magic);
-        MXC_SYS_Crit_Enter();
-        memcpy(const_cast<uint8_t *>(&txbuf[1]), &packet.header.checksum, 0x04);
-        memcpy(const_cast<uint8_t *>(&txbuf[5]), &packet.payload,
-               sizeof(payload_t<T>));
-        MXC_SYS_Crit_Exit();
+    template<packet_type_t T> void send_packet(const packet_writer_t<T> &) {
+        publish_tx_buffer(frame_size<T>());
     }
 
     /**
@@ -87,13 +177,14 @@ namespace i2c {
     /**
      * @brief Call the callback function
      *
-     * @param success_callback The callback function called on success
+     * @param buf The received command, the RX buffer unless it was queued
      * @return mitre_error_t Whether the callback was successful
      *
      */
-    inline error_t call_processing_callback() {
+    inline error_t call_processing_callback(
+        const volatile uint8_t *const buf = rxbuf) {
         if (processing_cb == nullptr) { return error_t::ERROR; }
-        return processing_cb(const_cast<uint8_t *>(rxbuf));
+        return processing_cb(const_cast<const uint8_t *>(buf));
     }
 
     /**
@@ -0,0 +1,84 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer single-consumer ring of fixed-size slots
+ * @version 0.1
+ *
+ * One side may be an ISR. The producer fills the slot returned by back() in
+ * place and publishes it with push(), the consumer reads the slot returned by
+ * front() in place and hands it back with pop(). Each index is only written by
+ * its own side, so neither needs to mask interrupts
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef SPSC_RING
+#define SPSC_RING
+
+#include "mxc_device.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Ring of Depth slots of type T
+ *
+ * @tparam T Slot type
+ * @tparam Depth Number of slots, a power of two
+ */
+template<typename T, uint32_t Depth> class spsc_ring_t {
+    static_assert(Depth != 0 && (Depth & (Depth - 1)) == 0,
+                  "Depth must be a power of two");
+
+  public:
+    /**
+     * @brief Free slot for the producer to fill
+     *
+     * @return T* Slot, nullptr if the ring is full
+     */
+    T *back() {
+        if (full()) { return nullptr; }
+        // The consumer's reads of the slot happen before it is reused
+        __DMB();
+        return &slots[head & (Depth - 1)];
+    }
+
+    /**
+     * @brief Publish the slot filled through back()
+     *
+     */
+    void push() {
+        __DMB();
+        head = head + 1;
+    }
+
+    /**
+     * @brief Oldest published slot for the consumer to read
+     *
+     * @return T* Slot, nullptr if the ring is empty
+     */
+    T *front() {
+        if (empty()) { return nullptr; }
+        // The producer's writes to the slot are visible before it is read
+        __DMB();
+        return &slots[tail & (Depth - 1)];
+    }
+
+    /**
+     * @brief Hand the slot read through front() back to the producer
+     *
+     */
+    void pop() {
+        __DMB();
+        tail = tail + 1;
+    }
+
+    bool empty() const { return head == tail; }
+
+    bool full() const { return head - tail == Depth; }
+
+  private:
+    T slots[Depth] = {};
+    volatile uint32_t head = 0;  // Written by the producer only
+    volatile uint32_t tail = 0;  // Written by the consumer only
+};
+
+#endif /* SPSC_RING */
@@ -2,9 +2,13 @@ import secrets
 
 from cryptography.hazmat.backends import default_backend
 
+from cryptography.hazmat.primitives.asymmetric import ec
+from cryptography.hazmat.primitives.asymmetric.utils import decode_dss_signature
+
 from cryptography.hazmat.primitives.ciphers import Cipher
 from cryptography.hazmat.primitives.ciphers.algorithms import AES
 from cryptography.hazmat.primitives.ciphers.modes import CTR
+from cryptography.hazmat.primitives.hashes import SHA256
 
 input_component = open("inc/ectf_params.h", "rt", encoding="utf-8")
 output = open("inc/ectf_params_secure.h", "wt", encoding="utf-8")
@@ -54,6 +58,45 @@ def parse_global_attest() -> tuple[bytes, bytes]:
     return attest_key_unwrapped, attest_nonce
 
 
+def parse_global_key(name: str) -> bytes:
+    """Parse a key array from the deployment secrets
+
+    Args:
+        name (str): Variable name of the key
+
+    Raises:
+        ValueError: If the key is missing
+
+    Returns:
+        bytes: The key
+    """
+    lines: list[str] = open(
+        "../deployment/global_secrets_secure.h", "rt", encoding="utf-8"
+    ).readlines()
+    for line in lines:
+        if f" {name}[" in line:
+            values = line.split("{")[1].split("}")[0].strip(",").split(",")
+            return bytes(int(value) for value in values)
+    raise ValueError(f"Missing {name}")
+
+
+def sign(message: bytes, key: bytes) -> bytes:
+    """Sign a message the way uECC_sign does over its SHA-256 hash
+
+    Args:
+        message (bytes): Message to sign
+        key (bytes): Big-endian secp256r1 private key
+
+    Returns:
+        bytes: Raw r || s signature
+    """
+    private_key = ec.derive_private_key(
+        int.from_bytes(key, "big"), ec.SECP256R1(), default_backend()
+    )
+    r, s = decode_dss_signature(private_key.sign(message, ec.ECDSA(SHA256())))
+    return r.to_bytes(32, "big") + s.to_bytes(32, "big")
+
+
 def encrypt_attestation(
     loc: str, date: str, cust: str, nonce: bytes, key: bytes
 ) -> tuple[bytes, bytes, bytes]:
@@ -156,6 +199,16 @@ write("uint8_t[]", "ATTEST_NONCE", [f"{b}" for b in attest_nonce])
 write("uint8_t[]", "ATTEST_LOC_ENC", [f"{b}" for b in attest_loc])
 write("uint8_t[]", "ATTEST_DATE_ENC", [f"{b}" for b in attest_date])
 write("uint8_t[]", "ATTEST_CUST_ENC", [f"{b}" for b in attest_cust])
+
+# Sign the encrypted blobs once instead of in process_attest
+attest_priv = parse_global_key("ATTEST_C_PRIV")
+write("uint8_t[]", "ATTEST_LOC_SIG", [f"{b}" for b in sign(attest_loc, attest_priv)])
+write(
+    "uint8_t[]", "ATTEST_DATE_SIG", [f"{b}" for b in sign(attest_date, attest_priv)]
+)
+write(
+    "uint8_t[]", "ATTEST_CUST_SIG", [f"{b}" for b in sign(attest_cust, attest_priv)]
+)
 write("uint8_t[]", "COMPONENT_BOOT_MSG", [f"{b}" for b in component_boot_msg.encode()])
 write("uint32_t", "COMPONENT_ID", [component_id])
 
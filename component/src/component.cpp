@@ -15,15 +15,18 @@
 #include "board.h"
 #include "crc32.h"
 #include "errors.h"
+#include "events.h"
 #include "flc.h"
 #include "i2c.h"
 #include "led.h"
 #include "mxc_delay.h"
 #include "mxc_errors.h"
+#include "nonce_pool.h"
 #include "nvic_table.h"
 #include "packets.h"
 #include "random.h"
 #include "simple_i2c_peripheral.h"
+#include "spsc_ring.h"
 #include "tinycrypt/ctr_mode.h"
 #include "tinycrypt/ecc.h"
 #include "tinycrypt/ecc_dh.h"
@@ -53,29 +56,53 @@ static uint8_t private_key[32] = {};
 static uint8_t public_key[64] = {};
 static uint32_t nonce = {};
 static uint8_t ctr[16] = {};
-static uint8_t aes_key[16] = {};
+static tc_aes_session_struct aes_session = {};
+
+// HMAC_KEY's padded blocks, hashed once per key exchange
+static tc_hmac_midstate_struct hmac_midstate = {};
+
+static nonce_pool_t<NONCE_POOL_DEPTH> sign_nonces;
 
 using namespace i2c;
 
-static volatile uint8_t securebuf[255] = {};
-static volatile uint8_t securelen = {};
+// Longest secure message, the data field of a secure packet
+constexpr const uint32_t SECURE_MESSAGE_LEN =
+    sizeof(payload_t<packet_type_t::SECURE>::data);
+
+/**
+ * @brief Secure message waiting in a queue
+ *
+ */
+struct secure_message_t {
+    alignas(4) uint8_t data[SECURE_MESSAGE_LEN];
+    uint8_t len;
+};
+
+// Messages from the AP to the application, filled by the I2C handler
+static spsc_ring_t<secure_message_t, SECURE_QUEUE_DEPTH> secure_rx = {};
+// Messages from the application to the AP, drained by the I2C handler
+static spsc_ring_t<secure_message_t, SECURE_QUEUE_DEPTH> secure_tx = {};
 
 void secure_send(const uint8_t *const buffer, const uint8_t len) {
-    MXC_SYS_Crit_Enter();
-    memcpy(const_cast<uint8_t *>(securebuf), buffer, len);
-    MXC_SYS_Crit_Exit();
-    securelen = len;
-    while (securelen != 0) { continue; }
-    return;
+    secure_message_t *message = nullptr;
+    while ((message = secure_tx.back()) == nullptr) {
+        events::wait(events::event_t::SECURE);
+    }
+    message->len = len < SECURE_MESSAGE_LEN ? len : SECURE_MESSAGE_LEN;
+    memcpy(message->data, buffer, message->len);
+    secure_tx.push();
 }
 
 int secure_receive(uint8_t *const buffer) {
-    while (securelen == 0) { continue; }
-    MXC_SYS_Crit_Enter();
-    memcpy(buffer, const_cast<uint8_t *>(securebuf), securelen);
-    MXC_SYS_Crit_Exit();
-    for (uint8_t i = 0; i < 255; ++i) { securebuf[i] = 0; }
-    return securelen;
+    secure_message_t *message = nullptr;
+    while ((message = secure_rx.front()) == nullptr) {
+        events::wait(events::event_t::SECURE);
+    }
+    const uint8_t len = message->len;
+    memcpy(buffer, message->data, len);
+    scrub(message->data, len);
+    secure_rx.pop();
+    return len;
 }
 
 static void boot() {
@@ -118,6 +145,9 @@ error_t component_process_cmd(const uint8_t *const data) {
             case packet_magic_t::BOOT:
                 return process_boot(data);
                 break;
+            case packet_magic_t::BOOT_BROADCAST:
+                return process_boot_broadcast(data);
+                break;
             default:
                 return error_t::ERROR;
         }
@@ -136,169 +166,204 @@ error_t component_process_cmd(const uint8_t *const data) {
 }
 
 error_t process_boot(const uint8_t *const data) {
-    packet_t<packet_type_t::BOOT_COMMAND> rx_packet;
-    rx_packet.header.magic = static_cast<packet_magic_t>(data[0]);
+    const packet_view_t<packet_type_t::BOOT_COMMAND> rx_packet(data);
 
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(&rx_packet.payload, &data[5], sizeof(rx_packet.payload));
+    if (!rx_packet.valid()) {
+        // Invalid packet
+        return error_t::ERROR;
+    } else if (rx_packet.payload().len != 0x60) {
+        // Invalid payload length
+        return error_t::ERROR;
+    } else if (uECC_verify_table(BOOT_A_TABLE, VERIFY_TABLE_WIDTH,
+                                 rx_packet.payload().data, 0x20,
+                                 rx_packet.payload().sig,
+                                 uECC_secp256r1()) != 1) {
+        // Invalid signature
+        return error_t::ERROR;
+    }
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
+    packet_writer_t<packet_type_t::BOOT_ACK> tx_packet =
+        begin_packet<packet_type_t::BOOT_ACK>();
+    tx_packet.set_magic(packet_magic_t::BOOT_ACK);
+    tx_packet.payload().len = 0x40;
+    memcpy(tx_packet.payload().data, COMPONENT_BOOT_MSG, 0x40);
 
-    if (rx_packet.header.magic != packet_magic_t::BOOT) {
-        // Invalid magic
+    if (sign_nonces.sign(BOOT_C_PRIV, rx_packet.payload().data, 0x20,
+                         tx_packet.payload().sig) != error_t::SUCCESS) {
+        // Couldn't sign
         return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    }
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+
+    send_packet(tx_packet);
+    boot_state = bootstate_t::POSTBOST;
+    events::signal(events::event_t::BOOT);
+    return error_t::SUCCESS;
+}
+
+error_t process_boot_broadcast(const uint8_t *const data) {
+    const packet_view_t<packet_type_t::BOOT_BROADCAST> rx_packet(data);
+
+    bool listed = false;
+    for (uint8_t i = 0;
+         i < rx_packet.payload().cnt && i < BROADCAST_MAX_COMPONENTS; ++i) {
+        if (rx_packet.payload().ids[i] == COMPONENT_ID) { listed = true; }
+    }
+
+    uint8_t hash[32] = {};
+    tc_sha256_state_struct sha256_ctx = {};
+    tc_sha256_init(&sha256_ctx);
+    tc_sha256_update(&sha256_ctx, rx_packet.payload().data, 0x20);
+    tc_sha256_update(&sha256_ctx, &rx_packet.payload().cnt, 1);
+    tc_sha256_update(&sha256_ctx,
+                     reinterpret_cast<const uint8_t *>(rx_packet.payload().ids),
+                     sizeof(rx_packet.payload().ids));
+    tc_sha256_final(hash, &sha256_ctx);
+
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x60) {
+    } else if (rx_packet.payload().len != sizeof(rx_packet.payload()) - 1) {
         // Invalid payload length
         return error_t::ERROR;
-    } else if (uECC_verify(BOOT_A_PUB, rx_packet.payload.data, 0x20,
-                           rx_packet.payload.sig, uECC_secp256r1()) != 1) {
+    } else if (rx_packet.payload().cnt > BROADCAST_MAX_COMPONENTS) {
+        // Invalid component count
+        return error_t::ERROR;
+    } else if (!listed) {
+        // Not provisioned on this AP
+        return error_t::ERROR;
+    } else if (uECC_verify_table(BOOT_A_TABLE, VERIFY_TABLE_WIDTH, hash, 32,
+                                 rx_packet.payload().sig,
+                                 uECC_secp256r1()) != 1) {
         // Invalid signature
         return error_t::ERROR;
     }
 
-    packet_t<packet_type_t::BOOT_ACK> tx_packet;
-    tx_packet.header.magic = packet_magic_t::BOOT_ACK;
-    tx_packet.payload.len = 0x40;
-    memcpy(tx_packet.payload.data, COMPONENT_BOOT_MSG, 0x40);
+    packet_writer_t<packet_type_t::BOOT_ACK> tx_packet =
+        begin_packet<packet_type_t::BOOT_ACK>();
+    tx_packet.set_magic(packet_magic_t::BOOT_ACK);
+    tx_packet.payload().len = 0x40;
+    memcpy(tx_packet.payload().data, COMPONENT_BOOT_MSG, 0x40);
+
+    // Bind the response to this component
+    sha256_ctx = {};
+    tc_sha256_init(&sha256_ctx);
+    tc_sha256_update(&sha256_ctx, rx_packet.payload().data, 0x20);
+    tc_sha256_update(&sha256_ctx,
+                     reinterpret_cast<const uint8_t *>(&COMPONENT_ID),
+                     sizeof(COMPONENT_ID));
+    tc_sha256_final(hash, &sha256_ctx);
 
-    if (uECC_sign(BOOT_C_PRIV, rx_packet.payload.data, 0x20,
-                  tx_packet.payload.sig, uECC_secp256r1()) != 1) {
+    if (sign_nonces.sign(BOOT_C_PRIV, hash, 32, tx_packet.payload().sig) !=
+        error_t::SUCCESS) {
         // Couldn't sign
         return error_t::ERROR;
     }
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-    send_packet<packet_type_t::BOOT_ACK>(tx_packet);
+    send_packet(tx_packet);
     boot_state = bootstate_t::POSTBOST;
+    events::signal(events::event_t::BOOT);
     return error_t::SUCCESS;
 }
 
 error_t process_list(const uint8_t *const data) {
-    packet_t<packet_type_t::LIST_COMMAND> rx_packet = {};
-    rx_packet.header.magic = static_cast<packet_magic_t>(data[0]);
-
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(&rx_packet.payload, &data[5], sizeof(rx_packet.payload));
+    const packet_view_t<packet_type_t::LIST_COMMAND> rx_packet(data);
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-
-    if (rx_packet.header.magic != packet_magic_t::LIST) {
-        // Invalid magic
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x00) {
+    } else if (rx_packet.payload().len != 0x00) {
         // Invalid payload length
         return error_t::ERROR;
     }
-    packet_t<packet_type_t::LIST_ACK> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::LIST_ACK;
-    tx_packet.payload.len = 0x04;
+    packet_writer_t<packet_type_t::LIST_ACK> tx_packet =
+        begin_packet<packet_type_t::LIST_ACK>();
+    tx_packet.set_magic(packet_magic_t::LIST_ACK);
+    tx_packet.payload().len = 0x04;
+    tx_packet.payload().speed = rx_packet.payload().speed < I2C_MAX_SPEED
+                                  ? rx_packet.payload().speed
+                                  : I2C_MAX_SPEED;
 
-    memcpy(tx_packet.payload.data, &COMPONENT_ID, 0x04);
+    memcpy(tx_packet.payload().data, &COMPONENT_ID, 0x04);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-    send_packet<packet_type_t::LIST_ACK>(tx_packet);
+    send_packet(tx_packet);
     return error_t::SUCCESS;
 }
 
 error_t process_attest(const uint8_t *const data) {
-    packet_t<packet_type_t::ATTEST_COMMAND> rx_packet = {};
-    rx_packet.header.magic = static_cast<packet_magic_t>(data[0]);
-
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(&rx_packet.payload, &data[5], sizeof(rx_packet.payload));
+    const packet_view_t<packet_type_t::ATTEST_COMMAND> rx_packet(data);
 
     tc_sha256_state_struct sha256_ctx = {};
     uint8_t hash[32] = {};
     tc_sha256_init(&sha256_ctx);
-    tc_sha256_update(&sha256_ctx, rx_packet.payload.data, 0x07);
+    tc_sha256_update(&sha256_ctx, rx_packet.payload().data, 0x07);
     tc_sha256_final(hash, &sha256_ctx);
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-    if (rx_packet.header.magic != packet_magic_t::ATTEST) {
-        // Invalid magic
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x07) {
+    } else if (rx_packet.payload().len != 0x07) {
         // Invalid payload length
         return error_t::ERROR;
-    } else if (memcmp(rx_packet.payload.data, "ATTEST", 0x06) != 0) {
+    } else if (memcmp(rx_packet.payload().data, "ATTEST", 0x06) != 0) {
         // Invalid payload
         return error_t::ERROR;
-    } else if (rx_packet.payload.data[6] > 0x03) {
+    } else if (rx_packet.payload().data[6] == 0x00 ||
+               rx_packet.payload().data[6] > 0x03) {
         // Invalid attest position
         return error_t::ERROR;
-    } else if (uECC_verify(ATTEST_A_PUB, hash, 32, rx_packet.payload.sig,
-                           uECC_secp256r1()) != 1) {
+    } else if (uECC_verify_table(ATTEST_A_TABLE, VERIFY_TABLE_WIDTH, hash,
+                                 32, rx_packet.payload().sig,
+                                 uECC_secp256r1()) != 1) {
         // Invalid signature
         return error_t::ERROR;
     }
 
-    packet_t<packet_type_t::ATTEST_ACK> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::ATTEST_ACK;
-    tx_packet.payload.len = 0x40;
-
-    if (rx_packet.payload.data[6] == 0x01) {
-        memcpy(tx_packet.payload.data, ATTEST_LOC_ENC, 0x40);
-    } else if (rx_packet.payload.data[6] == 0x02) {
-        memcpy(tx_packet.payload.data, ATTEST_DATE_ENC, 0x40);
-    } else if (rx_packet.payload.data[6] == 0x03) {
-        memcpy(tx_packet.payload.data, ATTEST_CUST_ENC, 0x40);
-    }
-
-    sha256_ctx = {};
-    tc_sha256_init(&sha256_ctx);
-    tc_sha256_update(&sha256_ctx, tx_packet.payload.data, 64);
-    tc_sha256_final(hash, &sha256_ctx);
-
-    if (uECC_sign(ATTEST_C_PRIV, hash, 0x20, tx_packet.payload.sig,
-                  uECC_secp256r1()) != 1) {
-        // Couldn't sign
-        return error_t::ERROR;
+    packet_writer_t<packet_type_t::ATTEST_ACK> tx_packet =
+        begin_packet<packet_type_t::ATTEST_ACK>();
+    tx_packet.set_magic(packet_magic_t::ATTEST_ACK);
+    tx_packet.payload().len = 0x40;
+
+    // The blobs and their signatures are fixed at build time
+    if (rx_packet.payload().data[6] == 0x01) {
+        memcpy(tx_packet.payload().data, ATTEST_LOC_ENC, 0x40);
+        memcpy(tx_packet.payload().sig, ATTEST_LOC_SIG, 0x40);
+    } else if (rx_packet.payload().data[6] == 0x02) {
+        memcpy(tx_packet.payload().data, ATTEST_DATE_ENC, 0x40);
+        memcpy(tx_packet.payload().sig, ATTEST_DATE_SIG, 0x40);
+    } else {
+        memcpy(tx_packet.payload().data, ATTEST_CUST_ENC, 0x40);
+        memcpy(tx_packet.payload().sig, ATTEST_CUST_SIG, 0x40);
     }
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
-    send_packet<packet_type_t::ATTEST_ACK>(tx_packet);
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+    send_packet(tx_packet);
     return error_t::SUCCESS;
 }
 
 error_t process_kex(const uint8_t *const data) {
-    packet_t<packet_type_t::KEX> rx_packet;
-    rx_packet.header.magic = static_cast<packet_magic_t>(data[0]);
-
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(&rx_packet.payload, &data[5], sizeof(rx_packet.payload));
+    const packet_view_t<packet_type_t::KEX> rx_packet(data);
 
-    const uint32_t expected_checksum =
-        calc_checksum(&rx_packet.payload, sizeof(rx_packet.payload));
-
-    if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_packet.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x40) {
+    } else if (rx_packet.payload().len != 0x40) {
         // Invalid payload length
         return error_t::ERROR;
-    } else if (uECC_valid_public_key(rx_packet.payload.material,
+    } else if (uECC_valid_public_key(rx_packet.payload().material,
                                      uECC_secp256r1()) < 0) {
         // Invalid public key
         return error_t::ERROR;
     }
 
-    uECC_shared_secret(rx_packet.payload.material, private_key, shared_secret,
+    uECC_shared_secret(rx_packet.payload().material, private_key, shared_secret,
                        uECC_secp256r1());
 
     uint8_t hash[32] = {};
@@ -309,175 +374,165 @@ error_t process_kex(const uint8_t *const data) {
 
     memcpy(ctr, "\x00X\xDA\xCC\x00X\xDA\xCC", 8);
     memcpy(&ctr[8], &hash[16], 0x8);
-    memcpy(aes_key, hash, 16);
-
-    packet_t<packet_type_t::KEX> tx_packet;
-    tx_packet.header.magic = packet_magic_t::KEX;
-    tx_packet.payload.len = 0x40;
-    memcpy(tx_packet.payload.material, public_key, 0x40);
-
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
-    send_packet<packet_type_t::KEX>(tx_packet);
+    tc_aes_session_begin(&aes_session, hash);
+    tc_hmac_set_midstate(&hmac_midstate, HMAC_KEY, 32);
+
+    packet_writer_t<packet_type_t::KEX> tx_packet =
+        begin_packet<packet_type_t::KEX>();
+    tx_packet.set_magic(packet_magic_t::KEX);
+    tx_packet.payload().len = 0x40;
+    memcpy(tx_packet.payload().material, public_key, 0x40);
+
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
+    send_packet(tx_packet);
     return error_t::SUCCESS;
 }
 
 error_t process_secure_send(const uint8_t *const data) {
-    uint8_t payload[sizeof(payload_t<packet_type_t::SECURE>)] = {};
-    tc_aes_key_sched_struct aes_ctx = {};
     tc_hmac_state_struct hmac_ctx = {};
 
     uint8_t hmac[32] = {};
 
-    packet_t<packet_type_t::SECURE_REQ> rx_packet = {};
-
-    rx_packet.header.magic = static_cast<packet_magic_t>(data[0]);
-
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(payload, &data[5], sizeof(payload));
+    const packet_view_t<packet_type_t::SECURE_REQ> rx_frame(data);
+    payload_t<packet_type_t::SECURE_REQ> rx_payload = {};
 
-    tc_aes128_set_encrypt_key(&aes_ctx, aes_key);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&rx_packet.payload),
-                sizeof(rx_packet.payload), payload, sizeof(payload), ctr,
-                &aes_ctx);
+    tc_ctr_mode_session(
+        reinterpret_cast<uint8_t *>(&rx_payload), sizeof(rx_payload),
+        reinterpret_cast<const uint8_t *>(&rx_frame.payload()),
+        sizeof(rx_frame.payload()), ctr, &aes_session);
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &rx_packet.payload,
-                   sizeof(rx_packet.payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &rx_payload, sizeof(rx_payload) - 32);
+    tc_hmac_final_midstate(hmac, 32, &hmac_ctx, &hmac_midstate);
 
-    const uint32_t expected_checksum = calc_checksum(payload, sizeof(payload));
-
-    if (rx_packet.header.magic != packet_magic_t::ENCRYPTED_REQ) {
-        // Invalid magic
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_frame.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.magic !=
+    } else if (rx_payload.magic !=
                static_cast<uint8_t>(packet_magic_t::DECRYPTED)) {
         // Invalid payload
         return error_t::ERROR;
-    } else if (rx_packet.payload.nonce != nonce) {
+    } else if (rx_payload.nonce != nonce) {
         // Invalid nonce
         return error_t::ERROR;
-    } else if (memcmp(hmac, rx_packet.payload.hmac, 32) != 0) {
+    } else if (memcmp(hmac, rx_payload.hmac, 32) != 0) {
         // HMAC failed
         return error_t::ERROR;
-    } else if (rx_packet.payload.len != 0x00) {
+    } else if (rx_payload.len != 0x00) {
         // Invalid length
         return error_t::ERROR;
     }
 
-    packet_t<packet_type_t::SECURE> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::ENCRYPTED;
+    packet_writer_t<packet_type_t::SECURE> tx_packet =
+        begin_packet<packet_type_t::SECURE>();
+    tx_packet.set_magic(packet_magic_t::ENCRYPTED);
+
+    // Built and then encrypted in place in the TX buffer
+    uint8_t *const payload = reinterpret_cast<uint8_t *>(&tx_packet.payload());
+    constexpr const uint32_t payload_len = sizeof(tx_packet.payload());
+
+    // An empty queue is answered with an empty message
+    secure_message_t *const message = secure_tx.front();
+    const uint8_t len = message != nullptr ? message->len : 0;
 
     payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
-    payload[1] = securelen;
+    payload[1] = len;
     memcpy(&payload[2], &nonce, 0x04);
+    if (message != nullptr) { memcpy(&payload[6], message->data, len); }
 
-    MXC_SYS_Crit_Enter();
-    memcpy(&payload[6], const_cast<uint8_t *>(securebuf), securelen);
-    MXC_SYS_Crit_Exit();
-
-    hmac_ctx = {};
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
-    memcpy(&payload[sizeof(payload) - 32], hmac, 32);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &payload[0], payload_len - 32);
+    tc_hmac_final_midstate(&payload[payload_len - 32], 32, &hmac_ctx,
+                           &hmac_midstate);
 
-    tc_aes128_set_encrypt_key(&aes_ctx, aes_key);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&tx_packet.payload),
-                sizeof(tx_packet.payload), payload, sizeof(payload), ctr,
-                &aes_ctx);
+    tc_ctr_mode_session(payload, payload_len, payload, payload_len, ctr,
+                        &aes_session);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-    for (uint8_t i = 0; i < 255; ++i) { securebuf[i] = 0; }
-    securelen = 0;
+    if (message != nullptr) {
+        scrub(message->data, len);
+        secure_tx.pop();
+        events::signal(events::event_t::SECURE);
+    }
     ++nonce;
-    send_packet<packet_type_t::SECURE>(tx_packet);
+    send_packet(tx_packet);
     return error_t::SUCCESS;
 }
 
 error_t process_secure_receive(const uint8_t *const data) {
-    uint8_t payload[sizeof(payload_t<packet_type_t::SECURE>)] = {};
-    tc_aes_key_sched_struct aes_ctx = {};
     tc_hmac_state_struct hmac_ctx = {};
 
     uint8_t hmac[32] = {};
 
-    packet_t<packet_type_t::SECURE> rx_packet = {};
-    rx_packet.header.magic = static_cast<packet_magic_t>(rxbuf[0]);
-
-    memcpy(&rx_packet.header.checksum, &data[1], 0x04);
-    memcpy(payload, &data[5], sizeof(payload));
+    const packet_view_t<packet_type_t::SECURE> rx_frame(data);
+    payload_t<packet_type_t::SECURE> rx_payload = {};
 
-    tc_aes128_set_encrypt_key(&aes_ctx, aes_key);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&rx_packet.payload),
-                sizeof(rx_packet.payload), payload, sizeof(payload), ctr,
-                &aes_ctx);
+    tc_ctr_mode_session(
+        reinterpret_cast<uint8_t *>(&rx_payload), sizeof(rx_payload),
+        reinterpret_cast<const uint8_t *>(&rx_frame.payload()),
+        sizeof(rx_frame.payload()), ctr, &aes_session);
 
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &rx_packet.payload,
-                   sizeof(rx_packet.payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &rx_payload, sizeof(rx_payload) - 32);
+    tc_hmac_final_midstate(hmac, 32, &hmac_ctx, &hmac_midstate);
 
-    const uint32_t expected_checksum = calc_checksum(payload, sizeof(payload));
-
-    if (rx_packet.header.magic != packet_magic_t::ENCRYPTED) {
-        // Invalid magic
-        return error_t::ERROR;
-    } else if (rx_packet.header.checksum != expected_checksum) {
-        // Checksum failed
+    if (!rx_frame.valid()) {
+        // Invalid packet
         return error_t::ERROR;
-    } else if (rx_packet.payload.magic !=
+    } else if (rx_payload.magic !=
                static_cast<uint8_t>(packet_magic_t::DECRYPTED)) {
         // Invalid payload
         return error_t::ERROR;
-    } else if (rx_packet.payload.nonce != nonce) {
+    } else if (rx_payload.nonce != nonce) {
         // Invalid nonce
         return error_t::ERROR;
-    } else if (memcmp(hmac, rx_packet.payload.hmac, 32) != 0) {
+    } else if (memcmp(hmac, rx_payload.hmac, 32) != 0) {
         // HMAC failed
         return error_t::ERROR;
+    } else if (rx_payload.len > SECURE_MESSAGE_LEN) {
+        // Invalid length
+        return error_t::ERROR;
+    }
+
+    secure_message_t *const message = secure_rx.back();
+    if (message == nullptr) {
+        // Queue full, the AP has to send it again
+        return error_t::ERROR;
     }
 
-    packet_t<packet_type_t::SECURE> tx_packet = {};
-    tx_packet.header.magic = packet_magic_t::ENCRYPTED;
+    packet_writer_t<packet_type_t::SECURE> tx_packet =
+        begin_packet<packet_type_t::SECURE>();
+    tx_packet.set_magic(packet_magic_t::ENCRYPTED);
+
+    // Built and then encrypted in place in the TX buffer
+    uint8_t *const payload = reinterpret_cast<uint8_t *>(&tx_packet.payload());
+    constexpr const uint32_t payload_len = sizeof(tx_packet.payload());
 
     payload[0] = static_cast<uint8_t>(packet_magic_t::DECRYPTED);
     payload[1] = 0;
     memcpy(&payload[2], &nonce, 0x04);
 
-    hmac_ctx = {};
-    tc_hmac_init(&hmac_ctx);
-    tc_hmac_set_key(&hmac_ctx, HMAC_KEY, 32);
-    tc_hmac_update(&hmac_ctx, &payload[0], sizeof(payload) - 32);
-    tc_hmac_final(hmac, 32, &hmac_ctx);
-    memcpy(&payload[sizeof(payload) - 32], hmac, 32);
+    tc_hmac_init_midstate(&hmac_ctx, &hmac_midstate);
+    tc_hmac_update(&hmac_ctx, &payload[0], payload_len - 32);
+    tc_hmac_final_midstate(&payload[payload_len - 32], 32, &hmac_ctx,
+                           &hmac_midstate);
 
-    aes_ctx = {};
-    tc_aes128_set_encrypt_key(&aes_ctx, aes_key);
-    tc_ctr_mode(reinterpret_cast<uint8_t *>(&tx_packet.payload),
-                sizeof(tx_packet.payload), payload, sizeof(payload), ctr,
-                &aes_ctx);
+    tc_ctr_mode_session(payload, payload_len, payload, payload_len, ctr,
+                        &aes_session);
 
-    tx_packet.header.checksum =
-        calc_checksum(&tx_packet.payload, sizeof(tx_packet.payload));
+    tx_packet.set_checksum(
+        calc_checksum(&tx_packet.payload(), sizeof(tx_packet.payload())));
 
-    MXC_SYS_Crit_Enter();
-    memcpy(const_cast<uint8_t *>(securebuf), rx_packet.payload.data,
-           rx_packet.payload.len);
-    MXC_SYS_Crit_Exit();
-    securelen = rx_packet.payload.len;
+    memcpy(message->data, rx_payload.data, rx_payload.len);
+    message->len = rx_payload.len;
+    secure_rx.push();
+    events::signal(events::event_t::SECURE);
 
     ++nonce;
-    send_packet<packet_type_t::SECURE>(tx_packet);
+    send_packet(tx_packet);
     return error_t::SUCCESS;
 }
 
@@ -485,20 +540,30 @@ int main() {
     // Enable Global Interrupts
     __enable_irq();
 
-    // Initialize Component
+    // Initialize Component, the key pair must exist before the first KEX
+    if (random_init() != error_t::SUCCESS) { return -1; }
+
+    uECC_make_key(public_key, private_key, uECC_secp256r1());
+
     i2c_addr_t addr = component_id_to_i2c_addr(COMPONENT_ID);
     if (i2c_simple_peripheral_init(addr, component_process_cmd) !=
         error_t::SUCCESS) {
         return -1;
     }
-    if (random_init() != error_t::SUCCESS) { return -1; }
-
-    uECC_make_key(public_key, private_key, uECC_secp256r1());
 
     LED_On(LED2);
 
+    // Sleep until the ISR queues a command or the component is booted,
+    // precomputing signing nonces first if there is nothing to do
+    constexpr const uint32_t work =
+        events::event_t::COMMAND | events::event_t::BOOT;
     while (true) {
+        while (!events::pending(work) && sign_nonces.fill()) {}
+        events::wait(work);
+        process_deferred();
         if (boot_state == bootstate_t::POSTBOST) {
+            print_i2c_trace();
+            events::print_wake_latency();
             boot();
             return 0;
         }
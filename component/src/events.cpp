@@ -0,0 +1,59 @@
+/**
+ * @file events.cpp
+ * @brief Work items signalled from interrupts to the component's main loop
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "events.h"
+
+#include "i2c_trace.h"
+#include "mxc.h"
+
+#include <stdio.h>
+
+namespace events {
+    static volatile uint32_t pending_mask = 0;
+
+    // Cycle count of the first signal since the main loop last woke
+    static volatile uint32_t signalled = 0;
+
+    static i2c::trace_stat_t wake_latency = {};
+
+    void signal(const event_t event) {
+        MXC_SYS_Crit_Enter();
+        if (pending_mask == 0) { signalled = i2c::trace_cycles(); }
+        pending_mask |= static_cast<uint32_t>(event);
+        MXC_SYS_Crit_Exit();
+        __SEV();
+    }
+
+    bool pending(const uint32_t mask) { return (pending_mask & mask) != 0; }
+
+    uint32_t wait(const uint32_t mask) {
+        bool slept = false;
+        while ((pending_mask & mask) == 0) {
+            __WFE();
+            slept = true;
+        }
+
+        MXC_SYS_Crit_Enter();
+        const uint32_t ready = pending_mask & mask;
+        pending_mask &= ~ready;
+        if (i2c::I2C_TRACE_ENABLED && slept) {
+            wake_latency.add(i2c::trace_cycles() - signalled);
+        }
+        MXC_SYS_Crit_Exit();
+        return ready;
+    }
+
+    void print_wake_latency() {
+        if (!i2c::I2C_TRACE_ENABLED || wake_latency.count == 0) { return; }
+        printf("%%debug: wake: %lu wake-ups, %lu/%lu/%lu cycles\n%%",
+               wake_latency.count, wake_latency.min, wake_latency.avg(),
+               wake_latency.max);
+        fflush(stdout);
+    }
+}  // namespace events
@@ -12,16 +12,184 @@
 #include "simple_i2c_peripheral.h"
 
 #include "errors.h"
+#include "events.h"
 #include "i2c.h"
+#include "i2c_trace.h"
 #include "mxc.h"
 #include "packets.h"
 
+#include <stdio.h>
+#include <string.h>
+
 namespace i2c {
-    volatile uint8_t txbuf[bufsize] = {};
-    volatile uint8_t rxbuf[bufsize] = {};
+    // Ping-pong buffers, one is filled while the other is sent or processed
+    alignas(4) static volatile uint8_t tx_buffers[2][bufsize] = {};
+    alignas(4) static volatile uint8_t rx_buffers[2][bufsize] = {};
+
+    // Sent in place of a response once it was read or failed
+    alignas(4) static const uint8_t zero_frame[bufsize] = {};
+
+    const volatile uint8_t *volatile txbuf = zero_frame;
+    volatile uint8_t *volatile rxbuf = rx_buffers[0];
     volatile uint32_t rxcnt = 0;
     volatile uint32_t txcnt = 0;
+    volatile uint32_t rxlen = bufsize;
+    volatile uint32_t txlen = bufsize;
     volatile i2c_cb_t processing_cb = nullptr;
+    volatile bool general_call = false;
+    volatile command_state_t command_state = command_state_t::IDLE;
+
+    // RX buffer not being received into. Owned by the main loop while a
+    // command is queued in it, scrubbed and idle otherwise
+    static volatile uint8_t *volatile cmdbuf = rx_buffers[1];
+    static volatile uint32_t cmdlen = 0;
+
+    // Bytes of the RX buffer written since it was last scrubbed
+    static volatile uint32_t rx_dirty = 0;
+
+    // TX buffer last published and the one responses are built in, only
+    // touched by the writer of responses
+    static volatile uint8_t *tx_front = tx_buffers[0];
+    static volatile uint8_t *tx_back = tx_buffers[1];
+    static uint32_t tx_front_dirty = 0;
+    static uint32_t tx_back_dirty = 0;
+
+    // DMA channels moving the FIFOs, and the length each was started with
+    static int dma_rx_ch = -1;
+    static int dma_tx_ch = -1;
+    static uint32_t dma_rx_len = 0;
+    static uint32_t dma_tx_len = 0;
+
+    // Answer the current read with a status byte instead of the TX buffer
+    static volatile bool reply_status = false;
+    static volatile packet_magic_t status_magic = packet_magic_t::BUSY;
+
+    // A command was rejected, see command_state_t
+    static volatile bool command_rejected = false;
+
+    /**
+     * @brief Cycle statistics of the exchanges seen by the ISR
+     *
+     */
+    struct trace_phases_t {
+        trace_stat_t isr;       // Spent in the ISR, callback included
+        trace_stat_t callback;  // Spent processing the command
+        trace_stat_t deferred;  // Queued until the response was ready
+        trace_stat_t total;     // Address match to STOP
+    };
+
+    /**
+     * @brief Exchange currently being traced
+     *
+     */
+    struct trace_exchange_t {
+        bool active;
+        packet_type_t type;
+        uint32_t start;
+        uint32_t isr;
+        uint32_t callback;
+    };
+
+    static trace_phases_t trace_stats[TRACE_TYPES] = {};
+    static trace_exchange_t trace = {};
+
+    // When the command waiting for the main loop was queued
+    static uint32_t trace_queued = 0;
+
+    /**
+     * @brief Record the exchange being traced, if any
+     *
+     * @param now Cycle count at the end of the exchange
+     */
+    static inline void trace_exchange_end(const uint32_t now) {
+        if (!I2C_TRACE_ENABLED || !trace.active) { return; }
+        trace.active = false;
+        // Address probes carry no packet
+        if (trace.type == packet_type_t::ERROR) { return; }
+        trace_phases_t &stats = trace_stats[trace_index(trace.type)];
+        stats.isr.add(trace.isr);
+        if (trace.callback != 0) { stats.callback.add(trace.callback); }
+        stats.total.add(now - trace.start);
+    }
+
+    /**
+     * @brief Start tracing an exchange on an address match
+     *
+     * An exchange still active was chained with a repeated START and never saw
+     * its STOP, so it ends here
+     *
+     * @param type Packet type the exchange is traced as until the command is
+     * processed
+     */
+    static inline void trace_exchange_begin(const packet_type_t type) {
+        if (!I2C_TRACE_ENABLED) { return; }
+        const uint32_t now = trace_cycles();
+        trace_exchange_end(now);
+        trace = {true, type, now, 0, 0};
+    }
+
+    /**
+     * @brief ISR entry hook
+     *
+     * @return uint32_t Cycle count on entry
+     */
+    static inline uint32_t trace_isr_enter() { return trace_cycles(); }
+
+    /**
+     * @brief ISR exit hook, charges the ISR to the exchange being traced
+     *
+     * @param start Cycle count on entry
+     * @param flags Interrupt flags the ISR handled
+     */
+    static inline void trace_isr_exit(const uint32_t start,
+                                      const uint32_t flags) {
+        if (!I2C_TRACE_ENABLED || !trace.active) { return; }
+        const uint32_t now = trace_cycles();
+        trace.isr += now - start;
+        if ((flags & MXC_F_I2C_INTFL0_STOP) != 0) { trace_exchange_end(now); }
+    }
+
+    /**
+     * @brief Call the processing callback and charge it to the exchange
+     *
+     * @return error_t Result of the callback
+     */
+    static inline error_t traced_processing_callback() {
+        if (!I2C_TRACE_ENABLED) { return call_processing_callback(); }
+        trace.type = packet_type_of(static_cast<packet_magic_t>(rxbuf[0]));
+        const uint32_t start = trace_cycles();
+        const error_t result = call_processing_callback();
+        trace.callback += trace_cycles() - start;
+        return result;
+    }
+
+    /**
+     * @brief Key the exchange by the command being queued
+     *
+     */
+    static inline void trace_queue() {
+        if (!I2C_TRACE_ENABLED) { return; }
+        trace.type = packet_type_of(static_cast<packet_magic_t>(rxbuf[0]));
+        trace_queued = trace_cycles();
+    }
+
+    /**
+     * @brief Call the processing callback on the queued command and record it
+     *
+     * @return error_t Result of the callback
+     */
+    static inline error_t traced_deferred_callback() {
+        if (!I2C_TRACE_ENABLED) { return call_processing_callback(cmdbuf); }
+        const packet_type_t type =
+            packet_type_of(static_cast<packet_magic_t>(cmdbuf[0]));
+        const uint32_t start = trace_cycles();
+        const error_t result = call_processing_callback(cmdbuf);
+        const uint32_t now = trace_cycles();
+        trace_phases_t &stats = trace_stats[trace_index(type)];
+        stats.callback.add(now - start);
+        stats.deferred.add(now - trace_queued);
+        return result;
+    }
 
     error_t i2c_simple_peripheral_init(const uint8_t addr, const i2c_cb_t cb) {
         int error = 0;
@@ -33,11 +201,23 @@ namespace i2c {
         MXC_I2C_SetFrequency(MXC_I2C1, I2C_FREQ);
         MXC_I2C_SetClockStretching(MXC_I2C1, 1);
         MXC_I2C_DisablePreload(MXC_I2C1);
+        trace_init();
+
+        if (I2C_PERIPHERAL_DMA) {
+            if (MXC_DMA_Init() != E_NO_ERROR) { return error_t::ERROR; }
+            dma_rx_ch = MXC_DMA_AcquireChannel();
+            dma_tx_ch = MXC_DMA_AcquireChannel();
+            if (dma_rx_ch < 0 || dma_tx_ch < 0) { return error_t::ERROR; }
+        }
 
         MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTFL0_RD_ADDR_MATCH, 0);
         MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTFL0_WR_ADDR_MATCH, 0);
         MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTFL0_STOP, 0);
 
+        // Accept broadcasts on the general call address
+        MXC_I2C1->ctrl |= MXC_F_I2C_CTRL_GC_ADDR_EN;
+        MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTEN0_GC_ADDR_MATCH, 0);
+
         MXC_NVIC_SetVector(MXC_I2C_GET_IRQ(MXC_I2C_GET_IDX(MXC_I2C1)),
                            i2c_simple_isr);
         NVIC_EnableIRQ(MXC_I2C_GET_IRQ(MXC_I2C_GET_IDX(MXC_I2C1)));
@@ -47,22 +227,229 @@ namespace i2c {
         return error_t::SUCCESS;
     }
 
+    /**
+     * @brief Bound the RX length once the magic byte has arrived
+     *
+     */
+    static inline void update_rxlen() {
+        if (!I2C_LENGTH_FRAMING || rxcnt == 0) { return; }
+        const uint32_t len = frame_size(static_cast<packet_magic_t>(rxbuf[0]));
+        rxlen = (len == 0 || len > bufsize) ? bufsize : len;
+    }
+
+    /**
+     * @brief Account for bytes read from the RX FIFO into the RX buffer
+     *
+     * @param count Number of bytes read
+     */
+    static inline void rx_advance(const uint32_t count) {
+        rxcnt += count;
+        if (rxcnt > rx_dirty) { rx_dirty = rxcnt; }
+        update_rxlen();
+    }
+
+    /**
+     * @brief Move any received bytes still in the RX FIFO into the RX buffer
+     *
+     */
+    static inline void drain_rx() {
+        const uint8_t available = MXC_I2C_GetRXFIFOAvailable(MXC_I2C1);
+
+        if (available > (rxlen - rxcnt) && rxcnt < rxlen) {
+            // Read the remaining bytes
+            rx_advance(
+                MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt, rxlen - rxcnt));
+        } else if (rxcnt < rxlen) {
+            // Read the available bytes
+            rx_advance(MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt, available));
+        }
+    }
+
+    /**
+     * @brief Start receiving the rest of the command into the RX buffer
+     *
+     * With DMA the FIFO is drained without interrupts up to the end of the
+     * buffer, the frame length is only applied once the transfer is stopped
+     */
+    static inline void start_rx() {
+        if (!I2C_PERIPHERAL_DMA) {
+            MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTEN0_RX_THD, 0);
+            return;
+        }
+
+        mxc_dma_config_t config = {};
+        config.ch = dma_rx_ch;
+        config.reqsel = MXC_DMA_REQUEST_I2C1RX;
+        config.srcwd = MXC_DMA_WIDTH_BYTE;
+        config.dstwd = MXC_DMA_WIDTH_BYTE;
+        config.srcinc_en = 0;
+        config.dstinc_en = 1;
+
+        mxc_dma_srcdst_t srcdst = {};
+        srcdst.ch = dma_rx_ch;
+        srcdst.dest = const_cast<uint8_t *>(rxbuf + rxcnt);
+        srcdst.len = static_cast<int>(bufsize - rxcnt);
+        dma_rx_len = bufsize - rxcnt;
+
+        MXC_DMA_ConfigChannel(config, srcdst);
+        MXC_DMA_Start(dma_rx_ch);
+        MXC_I2C1->dma |= MXC_F_I2C_DMA_RX_EN;
+    }
+
+    /**
+     * @brief Stop receiving with DMA and account for the bytes it moved
+     *
+     * Bytes still in the FIFO are left for drain_rx
+     */
+    static inline void stop_rx() {
+        if ((MXC_I2C1->dma & MXC_F_I2C_DMA_RX_EN) == 0) { return; }
+        MXC_I2C1->dma &= ~MXC_F_I2C_DMA_RX_EN;
+        MXC_DMA_Stop(dma_rx_ch);
+
+        mxc_dma_srcdst_t srcdst = {};
+        srcdst.ch = dma_rx_ch;
+        MXC_DMA_GetSrcDst(&srcdst);
+        rx_advance(dma_rx_len - static_cast<uint32_t>(srcdst.len));
+    }
+
+    /**
+     * @brief Start sending the TX buffer
+     *
+     * With DMA the whole buffer is queued, everything past the response is
+     * zero like the ISR sends once the response ran out
+     */
+    static inline void start_tx() {
+        if (!I2C_PERIPHERAL_DMA || reply_status) {
+            MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTEN0_TX_THD, 0);
+            return;
+        }
+
+        mxc_dma_config_t config = {};
+        config.ch = dma_tx_ch;
+        config.reqsel = MXC_DMA_REQUEST_I2C1TX;
+        config.srcwd = MXC_DMA_WIDTH_BYTE;
+        config.dstwd = MXC_DMA_WIDTH_BYTE;
+        config.srcinc_en = 1;
+        config.dstinc_en = 0;
+
+        mxc_dma_srcdst_t srcdst = {};
+        srcdst.ch = dma_tx_ch;
+        srcdst.source = const_cast<uint8_t *>(txbuf);
+        srcdst.len = static_cast<int>(bufsize);
+        dma_tx_len = bufsize;
+
+        MXC_DMA_ConfigChannel(config, srcdst);
+        MXC_DMA_Start(dma_tx_ch);
+        MXC_I2C1->dma |= MXC_F_I2C_DMA_TX_EN;
+    }
+
+    /**
+     * @brief Stop sending with DMA and account for the response bytes sent
+     *
+     */
+    static inline void stop_tx() {
+        if ((MXC_I2C1->dma & MXC_F_I2C_DMA_TX_EN) == 0) { return; }
+        MXC_I2C1->dma &= ~MXC_F_I2C_DMA_TX_EN;
+        MXC_DMA_Stop(dma_tx_ch);
+
+        mxc_dma_srcdst_t srcdst = {};
+        srcdst.ch = dma_tx_ch;
+        MXC_DMA_GetSrcDst(&srcdst);
+        const uint32_t sent = dma_tx_len - static_cast<uint32_t>(srcdst.len);
+        txcnt = sent < txlen ? sent : txlen;
+    }
+
+    /**
+     * @brief Drop the command in the RX buffer and answer reads with ERROR
+     *
+     */
+    static inline void reject_command() {
+        scrub(rxbuf, rx_dirty);
+        rx_dirty = 0;
+        rxcnt = 0;
+        rxlen = bufsize;
+        command_rejected = true;
+    }
+
+    /**
+     * @brief Hand the command in the RX buffer to the main loop
+     *
+     * A command arriving while another one is queued is rejected. Without
+     * deferred processing the command is processed right away
+     */
+    static inline void queue_command() {
+        if (rxcnt == 0) { return; }
+        if (command_state == command_state_t::QUEUED) {
+            reject_command();
+            return;
+        }
+        command_rejected = false;
+        trace_queue();
+
+        if (!I2C_DEFERRED_PROCESSING) {
+            const error_t result = traced_processing_callback();
+            if (result != error_t::SUCCESS) { clear(); }
+            command_state = command_state_t::READY;
+            return;
+        }
+
+        // Hand the RX buffer over and receive into the scrubbed spare
+        volatile uint8_t *const spare = cmdbuf;
+        cmdbuf = rxbuf;
+        cmdlen = rx_dirty;
+        rxbuf = spare;
+        rx_dirty = 0;
+        clear();
+        command_state = command_state_t::QUEUED;
+        events::signal(events::event_t::COMMAND);
+    }
+
+    /**
+     * @brief Whether the command in the RX buffer is answered within the
+     * exchange that wrote it
+     *
+     * Only the post-boot secure channel is, every other command verifies or
+     * signs and would stretch the clock for as long
+     *
+     * @return bool Whether the callback may run in the ISR
+     */
+    static inline bool runs_inline() {
+        if (!I2C_DEFERRED_PROCESSING) { return true; }
+        const packet_magic_t magic = static_cast<packet_magic_t>(rxbuf[0]);
+        return magic == packet_magic_t::ENCRYPTED ||
+               magic == packet_magic_t::ENCRYPTED_REQ;
+    }
+
+    /**
+     * @brief Drop the response to a queued command once the next one starts
+     *
+     */
+    static inline void release_response() {
+        if (command_state == command_state_t::READY) { clear(); }
+    }
+
+    /**
+     * @brief Finish a response that was read without a following STOP
+     *
+     * When the controller chains exchanges with repeated STARTs the STOP may
+     * only come after other devices were addressed, so the next address match
+     * is the first chance to reset
+     */
+    static inline void end_chained_exchange() {
+        if (txcnt > 0) { clear(); }
+        txcnt = 0;
+    }
+
     void i2c_simple_isr() {
+        const uint32_t trace_start = trace_isr_enter();
         const uint32_t flags = MXC_I2C1->intfl0;
 
         if ((flags & MXC_F_I2C_INTFL0_STOP) != 0) {
             // Transaction ended
 
-            const uint8_t available = MXC_I2C_GetRXFIFOAvailable(MXC_I2C1);
-
-            if (available > (bufsize - rxcnt) && rxcnt < bufsize) {
-                // Read the remaining bytes
-                rxcnt += MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt,
-                                            bufsize - rxcnt);
-            } else {
-                // Read the available bytes
-                rxcnt += MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt, available);
-            }
+            stop_rx();
+            stop_tx();
+            drain_rx();
 
             MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_RX_THD, 0);
             MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_TX_THD, 0);
@@ -75,13 +462,19 @@ namespace i2c {
                 // Clear the TX FIFO if anything is left
                 MXC_I2C_ClearTXFIFO(MXC_I2C1);
             }
-            if (txcnt > 0) {
+            if (general_call || (rxcnt > 0 && txcnt == 0)) {
+                // Command without a read, the response is polled for later
+                general_call = false;
+                queue_command();
+            } else if (txcnt > 0 && command_state != command_state_t::READY) {
                 // Clear the RX and TX buffers if the transaction is complete
                 clear();
             }
+            reply_status = false;
             // Reset state
             txcnt = 0;
             rxcnt = 0;
+            rxlen = bufsize;
 
             MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_STOP, 0);
         }
@@ -95,20 +488,27 @@ namespace i2c {
             }
 
             const uint8_t available = MXC_I2C_GetTXFIFOAvailable(MXC_I2C1);
-            if (txcnt >= bufsize) {
+            if (reply_status) {
                 uint8_t buf[8] = {};
+                memset(buf, static_cast<uint8_t>(status_magic), 8);
                 MXC_I2C_WriteTXFIFO(MXC_I2C1, buf, 8);
-            } else if (available > (bufsize - txcnt)) {
+                MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_TX_THD, 0);
+            } else if (txcnt >= txlen) {
+                uint8_t buf[8] = {};
+                MXC_I2C_WriteTXFIFO(MXC_I2C1, buf, 8);
+            } else if (available > (txlen - txcnt)) {
                 // Send the remaining bytes
-                txcnt += MXC_I2C_WriteTXFIFO(MXC_I2C1, txbuf + txcnt,
-                                             bufsize - txcnt);
+                txcnt += MXC_I2C_WriteTXFIFO(
+                    MXC_I2C1, const_cast<volatile uint8_t *>(txbuf + txcnt),
+                    txlen - txcnt);
             } else {
                 // Send the available bytes
-                txcnt +=
-                    MXC_I2C_WriteTXFIFO(MXC_I2C1, txbuf + txcnt, available);
+                txcnt += MXC_I2C_WriteTXFIFO(
+                    MXC_I2C1, const_cast<volatile uint8_t *>(txbuf + txcnt),
+                    available);
             }
 
-            if (txcnt >= bufsize) {
+            if (!reply_status && txcnt >= txlen) {
                 MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_TX_THD, 0);
             }
         }
@@ -117,66 +517,198 @@ namespace i2c {
             // Master requested a read from us
 
             txcnt = 0;
+            if (I2C_TRACE_ENABLED && !trace.active) {
+                // Poll for, or read of, the response to a queued command
+                const packet_magic_t magic =
+                    command_state == command_state_t::QUEUED
+                        ? packet_magic_t::BUSY
+                        : static_cast<packet_magic_t>(txbuf[0]);
+                trace_exchange_begin(packet_type_of(magic));
+            }
 
             MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_WR_ADDR_MATCH, 0);
 
             if ((flags & MXC_F_I2C_INTFL0_TX_LOCKOUT) != 0) {
                 // Call the callback function
 
+                // After a repeated START there was no STOP, so the tail of the
+                // command is still in the RX FIFO
+                stop_rx();
+                drain_rx();
+                MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_RX_THD, 0);
+                general_call = false;
+
                 txcnt = 0;
-                if (call_processing_callback() != error_t::SUCCESS) { clear(); }
+                if (rxcnt != 0 && command_state != command_state_t::QUEUED &&
+                    runs_inline()) {
+                    command_rejected = false;
+                    if (traced_processing_callback() != error_t::SUCCESS) {
+                        clear();
+                    }
+                } else {
+                    // Queued like a command followed by a STOP, the read
+                    // becomes the first poll. Polls and reads of a response
+                    // prepared earlier come without a command
+                    queue_command();
+                }
+
+                // The main loop owns the TX buffer while a command is queued
+                reply_status = command_rejected ||
+                               command_state == command_state_t::QUEUED;
+                status_magic = command_rejected ? packet_magic_t::ERROR
+                                                : packet_magic_t::BUSY;
 
                 MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_TX_LOCKOUT, 0);
             }
 
-            MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTEN0_TX_THD, 0);
+            start_tx();
+        }
+
+        if ((flags & MXC_F_I2C_INTFL0_GC_ADDR_MATCH) != 0) {
+            // Master broadcasting a write to everyone
+
+            trace_exchange_begin(packet_type_t::ERROR);
+            stop_tx();
+            end_chained_exchange();
+            release_response();
+            rxcnt = 0;
+            rxlen = bufsize;
+            general_call = true;
+
+            start_rx();
+
+            MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_GC_ADDR_MATCH, 0);
         }
 
         if ((flags & MXC_F_I2C_INTFL0_RD_ADDR_MATCH) != 0) {
             // Master requested a write to us
 
+            trace_exchange_begin(packet_type_t::ERROR);
+            stop_tx();
+            end_chained_exchange();
+            release_response();
             rxcnt = 0;
+            rxlen = bufsize;
 
-            MXC_I2C_EnableInt(MXC_I2C1, MXC_F_I2C_INTEN0_RX_THD, 0);
+            start_rx();
 
             MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_RD_ADDR_MATCH, 0);
         }
 
-        if ((flags & MXC_F_I2C_INTEN0_RX_THD) != 0) {
-            // Master writing more to us
+        if ((flags & MXC_F_I2C_INTEN0_RX_THD) != 0 &&
+            (MXC_I2C1->inten0 & MXC_F_I2C_INTEN0_RX_THD) != 0) {
+            // Master writing more to us, DMA owns the FIFO when enabled
 
             const uint8_t available = MXC_I2C_GetRXFIFOAvailable(MXC_I2C1);
-            if (rxcnt >= bufsize) {
+            if (rxcnt >= rxlen) {
                 // Clear the RX FIFO if we are full
                 MXC_I2C_ClearRXFIFO(MXC_I2C1);
-            } else if (available > (bufsize - rxcnt)) {
+            } else if (available > (rxlen - rxcnt)) {
                 // Read the remaining bytes
-                rxcnt += MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt,
-                                            bufsize - rxcnt);
+                rx_advance(MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt,
+                                              rxlen - rxcnt));
             } else {
                 // Read the available bytes
-                rxcnt += MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt, available);
+                rx_advance(
+                    MXC_I2C_ReadRXFIFO(MXC_I2C1, rxbuf + rxcnt, available));
             }
 
-            if (rxcnt >= bufsize) {
+            if (rxcnt >= rxlen) {
                 MXC_I2C_DisableInt(MXC_I2C1, MXC_F_I2C_INTEN0_RX_THD, 0);
             }
 
             MXC_I2C_ClearFlags(MXC_I2C1, MXC_F_I2C_INTFL0_RX_THD, 0);
         }
+
+        trace_isr_exit(trace_start, flags);
+    }
+
+    uint8_t *acquire_tx_buffer(uint32_t len) {
+        if (len > bufsize) { len = bufsize; }
+        // Bytes past len must be zero too when the whole buffer is sent
+        scrub(tx_back, len > tx_back_dirty ? len : tx_back_dirty);
+        tx_back_dirty = len;
+        return const_cast<uint8_t *>(tx_back);
+    }
+
+    void publish_tx_buffer(uint32_t len) {
+        if (len > bufsize) { len = bufsize; }
+        volatile uint8_t *const built = tx_back;
+        const uint32_t built_dirty = tx_back_dirty;
+        tx_back = tx_front;
+        tx_back_dirty = tx_front_dirty;
+        tx_front = built;
+        tx_front_dirty = built_dirty;
+
+        MXC_SYS_Crit_Enter();
+        txbuf = built;
+        txlen = I2C_LENGTH_FRAMING ? len : bufsize;
+        MXC_SYS_Crit_Exit();
     }
 
     void send_raw(const uint8_t *const buf, const uint32_t len) {
-        for (uint32_t i = 0; i < len; ++i) { txbuf[i] = buf[i]; }
+        uint8_t *const dst = acquire_tx_buffer(len);
+        memcpy(dst, buf, len < bufsize ? len : bufsize);
+        publish_tx_buffer(len);
     }
 
     void clear() {
-        for (uint32_t i = 0; i < bufsize; ++i) {
-            txbuf[i] = 0;
-            rxbuf[i] = 0;
-        }
+        // The response stays in its TX buffer until a new one is built there
+        scrub(rxbuf, rx_dirty);
+        rx_dirty = 0;
+        txbuf = zero_frame;
         rxcnt = 0;
         txcnt = 0;
+        rxlen = bufsize;
+        txlen = bufsize;
+        command_state = command_state_t::IDLE;
+    }
+
+    void process_deferred() {
+        if (command_state != command_state_t::QUEUED) { return; }
+
+        const error_t result = traced_deferred_callback();
+        scrub(cmdbuf, cmdlen);
+        cmdlen = 0;
+
+        MXC_SYS_Crit_Enter();
+        // The controller moved on if it sent another command in the meantime
+        if (result != error_t::SUCCESS || command_rejected) { clear(); }
+        command_state = command_state_t::READY;
+        MXC_SYS_Crit_Exit();
+    }
+
+    /**
+     * @brief Print the statistics of one phase like print_debug on the AP
+     *
+     * @param type Packet type
+     * @param phase Name of the phase
+     * @param stat Statistics of the phase
+     */
+    static void print_trace_stat(const packet_type_t type,
+                                 const char *const phase,
+                                 const trace_stat_t &stat) {
+        if (stat.count == 0) { return; }
+        printf("%%debug: %s %s: %lu/%lu/%lu\n%%", trace_name(type), phase,
+               stat.min, stat.avg(), stat.max);
+    }
+
+    void print_i2c_trace() {
+        if (!I2C_TRACE_ENABLED) { return; }
+        printf("%%debug: I2C trace, min/avg/max cycles at %luHz\n%%",
+               SystemCoreClock);
+        for (uint32_t i = 0; i < TRACE_TYPES; ++i) {
+            const packet_type_t type = static_cast<packet_type_t>(i);
+            const trace_phases_t &stats = trace_stats[i];
+            if (stats.total.count == 0) { continue; }
+            printf("%%debug: %s: %lu exchanges\n%%", trace_name(type),
+                   stats.total.count);
+            print_trace_stat(type, "isr", stats.isr);
+            print_trace_stat(type, "callback", stats.callback);
+            print_trace_stat(type, "deferred", stats.deferred);
+            print_trace_stat(type, "total", stats.total);
+        }
+        fflush(stdout);
     }
 
 }  // namespace i2c
@@ -0,0 +1,115 @@
+/**
+ * @file i2c_trace.h
+ * @brief Cycle-count tracing of I2C exchanges
+ * @version 0.1
+ *
+ * Built with -DI2C_TRACE the DWT cycle counter timestamps every exchange and
+ * min/avg/max statistics are kept per packet type. Without it every hook is
+ * an empty inline function and compiles away
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef TRACE
+#define TRACE
+
+#include "mxc_device.h"
+#include "packets.h"
+
+#include <stdint.h>
+
+namespace i2c {
+#ifdef I2C_TRACE
+    constexpr const bool I2C_TRACE_ENABLED = true;
+#else
+    constexpr const bool I2C_TRACE_ENABLED = false;
+#endif
+
+    // Number of packet types statistics are kept for
+    constexpr const uint32_t TRACE_TYPES =
+        static_cast<uint32_t>(packet_type_t::BUSY) + 1;
+
+    /**
+     * @brief Running min/avg/max of a cycle count
+     *
+     */
+    struct trace_stat_t {
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t total;
+
+        void add(const uint32_t cycles) {
+            if (count == 0 || cycles < min) { min = cycles; }
+            if (cycles > max) { max = cycles; }
+            total += cycles;
+            ++count;
+        }
+
+        uint32_t avg() const {
+            return count == 0 ? 0 : static_cast<uint32_t>(total / count);
+        }
+    };
+
+    /**
+     * @brief Start the DWT cycle counter
+     *
+     */
+    inline void trace_init() {
+        if (!I2C_TRACE_ENABLED) { return; }
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /**
+     * @brief Read the DWT cycle counter
+     *
+     * @return uint32_t Core cycles, wraps after 2^32
+     */
+    inline uint32_t trace_cycles() {
+        return I2C_TRACE_ENABLED ? static_cast<uint32_t>(DWT->CYCCNT) : 0;
+    }
+
+    /**
+     * @brief Index of a packet type in the statistics tables
+     *
+     * @param type Packet type
+     * @return uint32_t Index below TRACE_TYPES
+     */
+    constexpr uint32_t trace_index(const packet_type_t type) {
+        return static_cast<uint32_t>(type) < TRACE_TYPES
+                   ? static_cast<uint32_t>(type)
+                   : 0;
+    }
+
+    /**
+     * @brief Printable name of a packet type
+     *
+     * @param type Packet type
+     * @return const char* Name of the type
+     */
+    constexpr const char *trace_name(const packet_type_t type) {
+        constexpr const char *names[TRACE_TYPES] = {
+            "ERROR",  "KEX",        "LIST",           "LIST_ACK",
+            "ATTEST", "ATTEST_ACK", "BOOT",           "BOOT_ACK",
+            "SECURE", "SECURE_REQ", "BOOT_BROADCAST", "BUSY",
+        };
+        return names[trace_index(type)];
+    }
+
+    /**
+     * @brief Scale SCL cycles to core cycles
+     *
+     * @param scl_cycles Number of SCL cycles
+     * @param freq Bus frequency in Hz
+     * @return uint32_t Number of core cycles
+     */
+    inline uint32_t scl_to_core_cycles(const uint32_t scl_cycles,
+                                       const uint32_t freq) {
+        return static_cast<uint32_t>(
+            (static_cast<uint64_t>(scl_cycles) * SystemCoreClock) / freq);
+    }
+}  // namespace i2c
+
+#endif /* TRACE */
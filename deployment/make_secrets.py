@@ -1,10 +1,19 @@
 import secrets
+import sys
+
+from pathlib import Path
 
 from cryptography.hazmat.backends import default_backend
 
 from cryptography.hazmat.primitives.asymmetric import ec
 from cryptography.hazmat.primitives.serialization import Encoding, PublicFormat
 
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "lib" / "tinycrypt"))
+from ecc_comb_table import table, words
+
+# Comb width of the public key tables, 2^(width - 1) points of 64 bytes each
+VERIFY_TABLE_WIDTH = 6
+
 output = open("global_secrets_secure.h", "wt", encoding="utf-8")
 output.write(
     """
@@ -31,6 +40,26 @@ def gen_keypair() -> tuple[bytes, bytes]:
     )
 
 
+def verify_table(public_key: bytes) -> list[str]:
+    """Comb table of a public key for uECC_verify_table
+
+    Args:
+        public_key (bytes): Uncompressed public key without its 0x04 prefix
+
+    Returns:
+        list[str]: The table's points as uECC words
+    """
+    point = (
+        int.from_bytes(public_key[:32], "big"),
+        int.from_bytes(public_key[32:], "big"),
+    )
+    return [
+        word
+        for x, y in table(VERIFY_TABLE_WIDTH, point)
+        for word in words(x) + words(y)
+    ]
+
+
 def write(type: str, name: str, values: list[str], ap: bool, comp: bool) -> None:
     """Write a constant to the global_secrets.h file
 
@@ -87,6 +116,12 @@ write("uint8_t[]", "ATTEST_A_PRIV", [f"{b}" for b in attest_A_priv], True, False
 write("uint8_t[]", "ATTEST_C_PUB", [f"{b}" for b in attest_C_pub], True, False)
 write("uint8_t[]", "ATTEST_C_PRIV", [f"{b}" for b in attest_C_priv], False, True)
 
+write("uint8_t", "VERIFY_TABLE_WIDTH", [f"{VERIFY_TABLE_WIDTH}"], True, True)
+write("unsigned int[]", "BOOT_A_TABLE", verify_table(keypair_A_pub), False, True)
+write("unsigned int[]", "BOOT_C_TABLE", verify_table(keypair_C_pub), True, False)
+write("unsigned int[]", "ATTEST_A_TABLE", verify_table(attest_A_pub), False, True)
+write("unsigned int[]", "ATTEST_C_TABLE", verify_table(attest_C_pub), True, False)
+
 write("uint8_t[]", "HMAC_KEY", [f"{b}" for b in hmac_key], True, True)
 write(
     "uint8_t[]", "ATTEST_UNWRAPPED_NONCE", [f"{b}" for b in attest_nonce], True, False
@@ -0,0 +1,100 @@
+/**
+ * @file nonce_pool.h
+ * @brief Pool of ECDSA nonces precomputed while the device is idle
+ * @version 0.1
+ *
+ * Nearly all of a signature's cost is the k.G multiplication, which does not
+ * depend on the message. The firmware fills the pool one nonce at a time when
+ * it has nothing else to do and signs from it on the critical path, falling
+ * back to a full uECC_sign when the pool has run dry. Nonces are computed
+ * outside the pool and slots only change hands in critical sections, so
+ * signing from an ISR may preempt a fill
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef NONCE_POOL
+#define NONCE_POOL
+
+#include "errors.h"
+#include "mxc.h"
+#include "tinycrypt/ecc.h"
+#include "tinycrypt/ecc_dsa.h"
+#include "tinycrypt/utils.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Pool of single-use signing nonces
+ *
+ * @tparam Depth Number of nonces kept
+ */
+template<uint32_t Depth> class nonce_pool_t {
+    static_assert(Depth != 0, "Depth must not be zero");
+
+  public:
+    bool full() const { return count == Depth; }
+
+    /**
+     * @brief Precompute one nonce if there is room for it
+     *
+     * Takes as long as the scalar multiplication of a signature
+     *
+     * @return bool Whether a nonce was added, false once the pool is full
+     */
+    bool fill() {
+        if (full()) { return false; }
+        uECC_sign_nonce_t nonce = {};
+        if (uECC_sign_precompute(&nonce, uECC_secp256r1()) != 1) {
+            return false;
+        }
+
+        // A signature may have taken a slot while the nonce was computed
+        MXC_SYS_Crit_Enter();
+        const bool added = count != Depth;
+        if (added) { slots[count++] = nonce; }
+        MXC_SYS_Crit_Exit();
+
+        _set_secure(&nonce, 0, sizeof(nonce));
+        return added;
+    }
+
+    /**
+     * @brief Sign a hash with a pooled nonce, or from scratch if there is none
+     *
+     * The nonce used is zeroized whether or not signing succeeds
+     *
+     * @param private_key Signer's private key
+     * @param hash Hash to sign
+     * @param hash_size Length of the hash
+     * @param signature Output r || s, 64 bytes
+     * @return error_t Whether the hash was signed
+     */
+    error_t sign(const uint8_t *const private_key, const uint8_t *const hash,
+                 const unsigned hash_size, uint8_t *const signature) {
+        uECC_sign_nonce_t nonce = {};
+        MXC_SYS_Crit_Enter();
+        const bool pooled = count != 0;
+        if (pooled) {
+            --count;
+            nonce = slots[count];
+            _set_secure(&slots[count], 0, sizeof(slots[count]));
+        }
+        MXC_SYS_Crit_Exit();
+
+        if (pooled && uECC_sign_with_nonce(private_key, hash, hash_size, &nonce,
+                                           signature, uECC_secp256r1()) == 1) {
+            return error_t::SUCCESS;
+        }
+        return uECC_sign(private_key, hash, hash_size, signature,
+                         uECC_secp256r1()) == 1
+                   ? error_t::SUCCESS
+                   : error_t::ERROR;
+    }
+
+  private:
+    uECC_sign_nonce_t slots[Depth] = {};
+    volatile uint32_t count = 0;
+};
+
+#endif /* NONCE_POOL */
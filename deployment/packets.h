@@ -12,6 +12,7 @@
 #define PACKETS
 
 #include <stdint.h>
+#include <string.h>
 
 /**
  * @brief Packet magic values
@@ -28,7 +29,9 @@ enum class packet_magic_t : uint8_t {
     BOOT_ACK,
     DECRYPTED,
     ENCRYPTED,
-    ENCRYPTED_REQ
+    ENCRYPTED_REQ,
+    BOOT_BROADCAST,
+    BUSY
 };
 
 /**
@@ -45,9 +48,35 @@ enum class packet_type_t : uint8_t {
     BOOT_COMMAND,
     BOOT_ACK,
     SECURE,
-    SECURE_REQ
+    SECURE_REQ,
+    BOOT_BROADCAST,
+    BUSY
 };
 
+/**
+ * @brief Most components that can be booted with a single broadcast
+ *
+ */
+constexpr const uint32_t BROADCAST_MAX_COMPONENTS = 16;
+
+/**
+ * @brief I2C bus speeds a device can support
+ *
+ */
+enum class i2c_speed_t : uint8_t { STANDARD, FAST, FAST_PLUS };
+
+/**
+ * @brief Convert a bus speed to its SCL frequency
+ *
+ * @param speed Bus speed
+ * @return uint32_t Frequency in Hz
+ */
+constexpr uint32_t speed_to_freq(const i2c_speed_t speed) {
+    return speed == i2c_speed_t::FAST_PLUS ? 1000000
+           : speed == i2c_speed_t::FAST    ? 400000
+                                           : 100000;
+}
+
 /**
  * @brief Common packet header
  *
@@ -80,6 +109,7 @@ template<> struct __packed payload_t<packet_type_t::KEX> {
  */
 template<> struct __packed payload_t<packet_type_t::LIST_COMMAND> {
     uint8_t len;
+    i2c_speed_t speed;  // Fastest speed supported by the AP
 };
 
 /**
@@ -89,6 +119,7 @@ template<> struct __packed payload_t<packet_type_t::LIST_COMMAND> {
 template<> struct __packed payload_t<packet_type_t::LIST_ACK> {
     uint8_t len;
     uint8_t data[4];
+    i2c_speed_t speed;  // Fastest speed supported by both ends
 };
 
 /**
@@ -132,6 +163,20 @@ template<> struct __packed payload_t<packet_type_t::BOOT_ACK> {
     uint8_t sig[64];
 };
 
+/**
+ * @brief Broadcast boot command packet payload
+ * @note The signature is calculated over the hash of data, cnt and ids. Each
+ * component signs the hash of data and its own component ID
+ *
+ */
+template<> struct __packed payload_t<packet_type_t::BOOT_BROADCAST> {
+    uint8_t len;
+    uint8_t data[32];
+    uint8_t cnt;
+    uint32_t ids[BROADCAST_MAX_COMPONENTS];
+    uint8_t sig[64];
+};
+
 /**
  * @brief Secure packet payload
  *
@@ -158,6 +203,12 @@ template<> struct __packed payload_t<packet_type_t::SECURE_REQ> {
     uint8_t hmac[32];
 };
 
+/**
+ * @brief Busy status payload, sent while a queued command is being processed
+ *
+ */
+template<> struct __packed payload_t<packet_type_t::BUSY> {};
+
 /**
  * @brief Raw packet data
  *
@@ -168,4 +219,217 @@ template<packet_type_t T> struct packet_t {
     payload_t<T> payload;
 };
 
+/**
+ * @brief Size of the header as it appears on the wire (magic + checksum)
+ *
+ */
+constexpr const uint32_t wire_header_size =
+    sizeof(packet_magic_t) + sizeof(uint32_t);
+
+/**
+ * @brief Size of a full frame on the wire
+ *
+ * @tparam T Payload type
+ * @return uint32_t Header plus payload size in bytes
+ */
+template<packet_type_t T> constexpr uint32_t frame_size() {
+    return wire_header_size + sizeof(payload_t<T>);
+}
+
+/**
+ * @brief Largest frame either side will put on the wire
+ *
+ */
+constexpr const uint32_t max_frame_size = 256;
+
+/**
+ * @brief Offsets of the header fields and payload within a frame
+ *
+ */
+constexpr const uint32_t magic_offset = 0;
+constexpr const uint32_t checksum_offset =
+    magic_offset + sizeof(packet_magic_t);
+constexpr const uint32_t payload_offset = checksum_offset + sizeof(uint32_t);
+
+static_assert(payload_offset == wire_header_size, "Header layout mismatch");
+
+/**
+ * @brief Magic byte a frame of a packet type is sent with
+ *
+ * @tparam T Packet type
+ * @return packet_magic_t Magic byte on the wire
+ */
+template<packet_type_t T> constexpr packet_magic_t magic_of() {
+    switch (T) {
+        case packet_type_t::KEX:
+            return packet_magic_t::KEX;
+        case packet_type_t::LIST_COMMAND:
+            return packet_magic_t::LIST;
+        case packet_type_t::LIST_ACK:
+            return packet_magic_t::LIST_ACK;
+        case packet_type_t::ATTEST_COMMAND:
+            return packet_magic_t::ATTEST;
+        case packet_type_t::ATTEST_ACK:
+            return packet_magic_t::ATTEST_ACK;
+        case packet_type_t::BOOT_COMMAND:
+            return packet_magic_t::BOOT;
+        case packet_type_t::BOOT_ACK:
+            return packet_magic_t::BOOT_ACK;
+        case packet_type_t::SECURE:
+            return packet_magic_t::ENCRYPTED;
+        case packet_type_t::SECURE_REQ:
+            return packet_magic_t::ENCRYPTED_REQ;
+        case packet_type_t::BOOT_BROADCAST:
+            return packet_magic_t::BOOT_BROADCAST;
+        case packet_type_t::BUSY:
+            return packet_magic_t::BUSY;
+        default:
+            return packet_magic_t::ERROR;
+    }
+}
+
+// Defined in crc32.h, which may only be included by one file per image
+template<typename T>
+uint32_t calc_checksum(const T *const buf, const uint32_t len);
+
+/**
+ * @brief Writes a packet in place into a transmit buffer
+ *
+ * @tparam T Payload type
+ */
+template<packet_type_t T> class packet_writer_t {
+    static_assert(frame_size<T>() <= max_frame_size, "Frame too large");
+
+  public:
+    explicit packet_writer_t(uint8_t *const buf) : buf(buf) {}
+
+    void set_magic(const packet_magic_t magic) {
+        buf[magic_offset] = static_cast<uint8_t>(magic);
+    }
+
+    void set_checksum(const uint32_t checksum) {
+        memcpy(&buf[checksum_offset], &checksum, sizeof(checksum));
+    }
+
+    payload_t<T> &payload() {
+        return *reinterpret_cast<payload_t<T> *>(&buf[payload_offset]);
+    }
+
+  private:
+    uint8_t *const buf;
+};
+
+/**
+ * @brief Read-only view of a packet in a receive buffer
+ *
+ * The view is only valid as long as the buffer is not reused
+ *
+ * @tparam T Payload type
+ */
+template<packet_type_t T> class packet_view_t {
+    static_assert(frame_size<T>() <= max_frame_size, "Frame too large");
+
+  public:
+    explicit packet_view_t(const uint8_t *const buf) : buf(buf) {}
+
+    packet_magic_t magic() const {
+        return static_cast<packet_magic_t>(buf[magic_offset]);
+    }
+
+    uint32_t checksum() const {
+        uint32_t checksum = 0;
+        memcpy(&checksum, &buf[checksum_offset], sizeof(checksum));
+        return checksum;
+    }
+
+    const payload_t<T> &payload() const {
+        return *reinterpret_cast<const payload_t<T> *>(&buf[payload_offset]);
+    }
+
+    /**
+     * @brief Check the magic matches the packet type and the checksum
+     * matches the payload
+     *
+     * @return bool Whether the packet is well-formed
+     */
+    bool valid() const {
+        return magic() == magic_of<T>() &&
+               checksum() == calc_checksum(&payload(), sizeof(payload_t<T>));
+    }
+
+  private:
+    const uint8_t *const buf;
+};
+
+/**
+ * @brief Size of a full frame on the wire, looked up by its magic byte
+ *
+ * @param magic Magic byte of the frame
+ * @return uint32_t Header plus payload size in bytes, 0 if unknown
+ */
+constexpr uint32_t frame_size(const packet_magic_t magic) {
+    switch (magic) {
+        case packet_magic_t::KEX:
+            return frame_size<packet_type_t::KEX>();
+        case packet_magic_t::LIST:
+            return frame_size<packet_type_t::LIST_COMMAND>();
+        case packet_magic_t::LIST_ACK:
+            return frame_size<packet_type_t::LIST_ACK>();
+        case packet_magic_t::ATTEST:
+            return frame_size<packet_type_t::ATTEST_COMMAND>();
+        case packet_magic_t::ATTEST_ACK:
+            return frame_size<packet_type_t::ATTEST_ACK>();
+        case packet_magic_t::BOOT:
+            return frame_size<packet_type_t::BOOT_COMMAND>();
+        case packet_magic_t::BOOT_ACK:
+            return frame_size<packet_type_t::BOOT_ACK>();
+        case packet_magic_t::ENCRYPTED:
+            return frame_size<packet_type_t::SECURE>();
+        case packet_magic_t::ENCRYPTED_REQ:
+            return frame_size<packet_type_t::SECURE_REQ>();
+        case packet_magic_t::BOOT_BROADCAST:
+            return frame_size<packet_type_t::BOOT_BROADCAST>();
+        case packet_magic_t::BUSY:
+            return frame_size<packet_type_t::BUSY>();
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Packet type of a frame, looked up by its magic byte
+ *
+ * @param magic Magic byte of the frame
+ * @return packet_type_t Packet type, ERROR if unknown
+ */
+constexpr packet_type_t packet_type_of(const packet_magic_t magic) {
+    switch (magic) {
+        case packet_magic_t::KEX:
+            return packet_type_t::KEX;
+        case packet_magic_t::LIST:
+            return packet_type_t::LIST_COMMAND;
+        case packet_magic_t::LIST_ACK:
+            return packet_type_t::LIST_ACK;
+        case packet_magic_t::ATTEST:
+            return packet_type_t::ATTEST_COMMAND;
+        case packet_magic_t::ATTEST_ACK:
+            return packet_type_t::ATTEST_ACK;
+        case packet_magic_t::BOOT:
+            return packet_type_t::BOOT_COMMAND;
+        case packet_magic_t::BOOT_ACK:
+            return packet_type_t::BOOT_ACK;
+        case packet_magic_t::DECRYPTED:
+        case packet_magic_t::ENCRYPTED:
+            return packet_type_t::SECURE;
+        case packet_magic_t::ENCRYPTED_REQ:
+            return packet_type_t::SECURE_REQ;
+        case packet_magic_t::BOOT_BROADCAST:
+            return packet_type_t::BOOT_BROADCAST;
+        case packet_magic_t::BUSY:
+            return packet_type_t::BUSY;
+        default:
+            return packet_type_t::ERROR;
+    }
+}
+
 #endif
@@ -16,6 +16,27 @@
 
 #include <stdint.h>
 
+/**
+ * @brief AES session that ends, clearing its key, when it goes out of scope
+ *
+ */
+class aes_session_t {
+  public:
+    explicit aes_session_t(const uint8_t *const key) {
+        tc_aes_session_begin(&session, key);
+    }
+
+    ~aes_session_t() { tc_aes_session_end(&session); }
+
+    aes_session_t(const aes_session_t &) = delete;
+    aes_session_t &operator=(const aes_session_t &) = delete;
+
+    TCAesSession_t get() { return &session; }
+
+  private:
+    tc_aes_session_struct session = {};
+};
+
 /**
  * @brief Unwrap a key from flash
  *
@@ -28,9 +49,8 @@ inline void unwrap_aes_key(uint8_t *unwrapped_key,
                            const uint8_t *const wrapped_key,
                            const uint8_t *const wrapper_key,
                            uint8_t *const wrapper_nonce) {
-    tc_aes_key_sched_struct aes_key = {};
-
-    tc_aes128_set_encrypt_key(&aes_key, wrapper_key);
-    tc_ctr_mode(unwrapped_key, 16, wrapped_key, 16, wrapper_nonce, &aes_key);
+    aes_session_t session(wrapper_key);
+    tc_ctr_mode_session(unwrapped_key, 16, wrapped_key, 16, wrapper_nonce,
+                        session.get());
 }
 #endif /* UTILS */
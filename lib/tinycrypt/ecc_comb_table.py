@@ -0,0 +1,136 @@
+"""Fixed-base comb tables for secp256r1
+
+Writes src/ecc_comb_table.h, the affine multiples of G that EccPoint_mult_base
+combines, with one table for every width uECC_COMB_WIDTH can be built with,
+and the odd multiples of G that EccPoint_mult_twin_wnaf adds during
+verification. Run it again only if a layout changes; the output is checked in.
+
+deployment/make_secrets.py imports table() and words() to build the same kind
+of table for the provisioned public keys.
+"""
+
+from pathlib import Path
+
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+A = P - 3
+G = (
+    0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+    0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5,
+)
+
+NUM_BITS = 256
+# Bit 7 of a recoded digit is its sign, so the comb is at most 7 teeth wide
+WIDTHS = range(2, 8)
+# G, 3G, ..., 63G, for wNAF digits of up to 7 bits
+WNAF_WIDTH = 7
+
+
+def add(p, q):
+    """Affine point addition, None is the point at infinity"""
+    if p is None:
+        return q
+    if q is None:
+        return p
+    if p[0] == q[0]:
+        if (p[1] + q[1]) % P == 0:
+            return None
+        slope = (3 * p[0] * p[0] + A) * pow(2 * p[1], -1, P)
+    else:
+        slope = (q[1] - p[1]) * pow(q[0] - p[0], -1, P)
+    x = (slope * slope - p[0] - q[0]) % P
+    return (x, (slope * (p[0] - x) - p[1]) % P)
+
+
+def mult(k, p):
+    """Double-and-add, only ever run on public values"""
+    result = None
+    while k:
+        if k & 1:
+            result = add(result, p)
+        p = add(p, p)
+        k >>= 1
+    return result
+
+
+def words(value):
+    """Little-endian 32-bit words, the uECC native format"""
+    return [f"0x{(value >> (32 * i)) & 0xFFFFFFFF:08X}" for i in range(8)]
+
+
+def table(width, base=G):
+    """T[i] = P + sum of 2^(j * d) P over the bits j - 1 set in i"""
+    d = (NUM_BITS + width - 1) // width
+    teeth = [mult(1 << (j * d), base) for j in range(width)]
+    points = []
+    for i in range(1 << (width - 1)):
+        point = teeth[0]
+        for j in range(1, width):
+            if i & (1 << (j - 1)):
+                point = add(point, teeth[j])
+        points.append(point)
+    return points
+
+
+def odd_multiples(width, base=G):
+    """P, 3P, 5P, ... up to (2^(width - 1) - 1)P"""
+    double = add(base, base)
+    points = [base]
+    for _ in range(1, 1 << (width - 2)):
+        points.append(add(points[-1], double))
+    return points
+
+
+def rows(point):
+    """One table entry as four lines of x then y words"""
+    coords = words(point[0]) + words(point[1])
+    for row in range(0, 16, 4):
+        prefix = "\t{" if row == 0 else "\t "
+        suffix = "}," if row == 12 else ","
+        yield prefix + ", ".join(coords[row : row + 4]) + suffix
+
+
+def main():
+    """Write every width's generator table"""
+    lines = [
+        "/* ecc_comb_table.h - generated by ecc_comb_table.py, do not edit */",
+        "",
+        "#ifndef __TC_ECC_COMB_TABLE_H__",
+        "#define __TC_ECC_COMB_TABLE_H__",
+        "",
+        "#include <tinycrypt/ecc.h>",
+        "",
+    ]
+    for index, width in enumerate(WIDTHS):
+        lines.append(f"#{'el' if index else ''}if uECC_COMB_WIDTH == {width}")
+        lines.append(
+            "static const uECC_word_t "
+            f"ecc_comb_table[{1 << (width - 1)}][NUM_ECC_WORDS * 2] = {{"
+        )
+        for point in table(width):
+            lines += rows(point)
+        lines.append("};")
+    lines += [
+        "#elif uECC_COMB_WIDTH != 0",
+        f"	#error uECC_COMB_WIDTH must be 0 or {WIDTHS[0]} to {WIDTHS[-1]}",
+        "#endif",
+        "",
+        f"#define WNAF_G_WIDTH {WNAF_WIDTH}",
+        "static const uECC_word_t "
+        f"ecc_wnaf_table[{1 << (WNAF_WIDTH - 2)}][NUM_ECC_WORDS * 2] = {{",
+    ]
+    for point in odd_multiples(WNAF_WIDTH):
+        lines += rows(point)
+    lines += [
+        "};",
+        "",
+        "#endif /* __TC_ECC_COMB_TABLE_H__ */",
+        "",
+    ]
+
+    Path(__file__).parent.joinpath("src", "ecc_comb_table.h").write_text(
+        "\n".join(lines)
+    )
+
+
+if __name__ == "__main__":
+    main()
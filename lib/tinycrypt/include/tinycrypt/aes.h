@@ -93,6 +93,44 @@ int tc_aes128_set_encrypt_key(TCAesKeySched_t s, const uint8_t *k);
  */
 int tc_aes_encrypt(uint8_t *out, uint8_t *in, const TCAesKeySched_t s);
 
+/* Key loaded into the AES engine for many blocks */
+typedef struct tc_aes_session_struct {
+	struct tc_aes_key_sched_struct sched;
+} *TCAesSession_t;
+
+/**
+ *  @brief Begin an AES-128 encryption session
+ *  Uses key k for every block encrypted in session until tc_aes_session_end
+ *  @return  returns TC_CRYPTO_SUCCESS (1)
+ *           returns TC_CRYPTO_FAIL (0) if: session == NULL or k == NULL
+ *  @note The key is written to the engine on the first block and then stays
+ *        there for as long as no other key is used
+ *  @param session IN/OUT -- session to begin
+ *  @param k IN -- points to the AES key
+ */
+int tc_aes_session_begin(TCAesSession_t session, const uint8_t *k);
+
+/**
+ *  @brief Encrypt consecutive blocks in one request to the AES engine
+ *  @return  returns TC_CRYPTO_SUCCESS (1)
+ *           returns TC_CRYPTO_FAIL (0) if: session == NULL or out == NULL or
+ *           in == NULL or the engine failed
+ *  @note out and in must be word aligned and hold blocks * 16 bytes
+ *  @param session IN -- session begun with tc_aes_session_begin
+ *  @param out OUT -- buffer to receive the ciphertext blocks
+ *  @param in IN -- plaintext blocks
+ *  @param blocks IN -- number of blocks
+ */
+int tc_aes_session_encrypt(
+	TCAesSession_t session, uint8_t *out, const uint8_t *in,
+	unsigned int blocks);
+
+/**
+ *  @brief End an AES-128 encryption session, clearing its key
+ *  @param session IN/OUT -- session to end
+ */
+void tc_aes_session_end(TCAesSession_t session);
+
 #ifdef __cplusplus
 }
 #endif
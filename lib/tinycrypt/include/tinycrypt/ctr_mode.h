@@ -87,7 +87,7 @@ extern "C" {
  *                outlen == 0 or
  *                inlen != outlen
  *  @note Assumes:- The current value in ctr has NOT been used with sched
- *              - out points to inlen bytes
+ *              - out points to inlen bytes, possibly the same as in
  *              - in points to inlen bytes
  *              - ctr is an integer counter in littleEndian format
  *              - sched was initialized by aes_set_encrypt_key
@@ -102,6 +102,26 @@ int tc_ctr_mode(
 	uint8_t *out, unsigned int outlen, const uint8_t *in, unsigned int inlen,
 	uint8_t *ctr, const TCAesKeySched_t sched);
 
+/**
+ *  @brief CTR mode procedure with the key of an AES session.
+ *  Same as tc_ctr_mode, but the key stays in the AES engine between calls and
+ *  the counter blocks are encrypted several at a time
+ *  @note out may be the same buffer as in to encrypt (or decrypt) in place,
+ *        any other overlap is not supported
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) on the same conditions as tc_ctr_mode,
+ *          with session in place of sched
+ * @param out OUT -- produced ciphertext (plaintext)
+ * @param outlen IN -- length of ciphertext buffer in bytes
+ * @param in IN -- data to encrypt (or decrypt)
+ * @param inlen IN -- length of input data in bytes
+ * @param ctr IN/OUT -- the current counter value
+ * @param session IN -- session begun with tc_aes_session_begin
+ */
+int tc_ctr_mode_session(
+	uint8_t *out, unsigned int outlen, const uint8_t *in, unsigned int inlen,
+	uint8_t *ctr, TCAesSession_t session);
+
 #ifdef __cplusplus
 }
 #endif
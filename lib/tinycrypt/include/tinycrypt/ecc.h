@@ -85,6 +85,14 @@ extern "C" {
 	#define uECC_RNG_MAX_TRIES 64
 #endif
 
+/* width of the fixed-base comb used for multiples of the generator. Its table
+ * of 2^(uECC_COMB_WIDTH - 1) points takes 64 bytes each of flash, and a
+ * multiplication costs ceil(256 / uECC_COMB_WIDTH) doublings and additions.
+ * 0 drops the table and uses the Montgomery ladder (2..7 are valid): */
+#ifndef uECC_COMB_WIDTH
+	#define uECC_COMB_WIDTH 7
+#endif
+
 /* defining data types to store word and bit counts: */
 typedef int8_t wordcount_t;
 typedef int16_t bitcount_t;
@@ -271,6 +279,50 @@ int uECC_compute_public_key(
 uECC_word_t EccPoint_compute_public_key(
 	uECC_word_t *result, uECC_word_t *private_key, uECC_Curve curve);
 
+/*
+ * @brief Computes scalar * G in constant time with the fixed-base comb, or
+ * with EccPoint_mult when uECC_COMB_WIDTH is 0.
+ * @note The comb table only holds multiples of the secp256r1 generator.
+ * @param result OUT -- scalar * G
+ * @param scalar IN -- scalar, 0 < scalar < n
+ * @param curve IN -- elliptic curve
+ */
+void EccPoint_mult_base(
+	uECC_word_t *result, const uECC_word_t *scalar, uECC_Curve curve);
+
+#if uECC_COMB_WIDTH != 0
+/*
+ * @brief Computes u1 * G + u2 * Q from the generator comb and a comb table of
+ * Q, sharing the doublings between them. Not constant time, for verification
+ * where every input is public.
+ * @param result OUT -- u1 * G + u2 * Q, all zero for the point at infinity
+ * @param u1 IN -- scalar of G, u1 < n
+ * @param u2 IN -- scalar of Q, u2 < n
+ * @param table IN -- 2^(width - 1) affine points, entry i being Q plus
+ * 2^(j * d) * Q for every bit j - 1 set in i, with d = ceil(256 / width)
+ * @param width IN -- comb width of table, 2 to 7
+ * @param curve IN -- elliptic curve
+ */
+void EccPoint_mult_twin_vartime(
+	uECC_word_t *result, const uECC_word_t *u1, const uECC_word_t *u2,
+	const uECC_word_t *table, unsigned int width, uECC_Curve curve);
+#endif
+
+/*
+ * @brief Computes u1 * G + u2 * Q with width-w NAF recodings of both scalars,
+ * sharing the doublings between them and adding odd multiples of G from a
+ * table and of Q computed on the fly. Not constant time, for verification
+ * where every input is public.
+ * @param result OUT -- u1 * G + u2 * Q, all zero for the point at infinity
+ * @param u1 IN -- scalar of G, u1 < n
+ * @param u2 IN -- scalar of Q, u2 < n
+ * @param point IN -- Q, affine
+ * @param curve IN -- elliptic curve
+ */
+void EccPoint_mult_twin_wnaf(
+	uECC_word_t *result, const uECC_word_t *u1, const uECC_word_t *u2,
+	const uECC_word_t *point, uECC_Curve curve);
+
 /*
  * @brief Regularize the bitcount for the private key so that attackers cannot
  * use a side channel attack to learn the number of leading zeros.
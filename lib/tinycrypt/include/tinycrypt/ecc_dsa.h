@@ -107,6 +107,46 @@ int uECC_sign(
 	const uint8_t *p_private_key, const uint8_t *p_message_hash,
 	unsigned p_hash_size, uint8_t *p_signature, uECC_Curve curve);
 
+/* Signing nonce precomputed by uECC_sign_precompute(): */
+typedef struct uECC_sign_nonce {
+	uECC_word_t k_inv[NUM_ECC_WORDS]; /* 1 / k mod n */
+	uECC_word_t r[NUM_ECC_WORDS];	  /* (k.G).x */
+} uECC_sign_nonce_t;
+
+/**
+ * @brief Precompute the message independent part of an ECDSA signature.
+ * @return returns TC_CRYPTO_SUCCESS (1) if the nonce was generated
+ *         returns TC_CRYPTO_FAIL (0) if an error occurred.
+ *
+ * @param p_nonce OUT -- Will be filled in with a fresh random nonce.
+ *
+ * @warning A cryptographically-secure PRNG function must be set (using
+ * uECC_set_rng()) before calling uECC_sign_precompute().
+ * @warning The nonce must be kept secret and used for a single signature.
+ * @note The k.G scalar multiplication dominates uECC_sign(), so doing it ahead
+ * of time leaves only a few modular multiplications for the signature.
+ */
+int uECC_sign_precompute(uECC_sign_nonce_t *p_nonce, uECC_Curve curve);
+
+/**
+ * @brief Generate an ECDSA signature from a precomputed nonce.
+ * @return returns TC_CRYPTO_SUCCESS (1) if the signature generated successfully
+ *         returns TC_CRYPTO_FAIL (0) if an error occurred.
+ *
+ * @param p_private_key IN -- Your private key.
+ * @param p_message_hash IN -- The hash of the message to sign.
+ * @param p_hash_size IN -- The size of p_message_hash in bytes.
+ * @param p_nonce IN/OUT -- Nonce from uECC_sign_precompute(), zeroized on
+ * return whether or not the signature was generated.
+ * @param p_signature OUT -- Will be filled in with the signature value. Must be
+ * at least 2 * curve size long (for secp256r1, signature must be 64 bytes
+ * long).
+ */
+int uECC_sign_with_nonce(
+	const uint8_t *p_private_key, const uint8_t *p_message_hash,
+	unsigned p_hash_size, uECC_sign_nonce_t *p_nonce, uint8_t *p_signature,
+	uECC_Curve curve);
+
 #ifdef ENABLE_TESTS
 /*
  * THIS FUNCTION SHOULD BE CALLED FOR TEST PURPOSES ONLY.
@@ -131,11 +171,34 @@ int uECC_sign_with_k(
  * @note Usage: Compute the hash of the signed data using the same hash as the
  * signer and pass it to this function along with the signer's public key and
  * the signature values (hash_size and signature).
+ * @note Computes u1.G + u2.Q in variable time with EccPoint_mult_twin_wnaf,
+ * which is safe since every input is public.
  */
 int uECC_verify(
 	const uint8_t *p_public_key, const uint8_t *p_message_hash,
 	unsigned int p_hash_size, const uint8_t *p_signature, uECC_Curve curve);
 
+/**
+ * @brief Verify an ECDSA signature against a public key known in advance.
+ * @return returns TC_SUCCESS (1) if the signature is valid
+ * 	   returns TC_FAIL (0) if the signature is invalid.
+ *
+ * @param p_table IN -- Comb table of the signer's public key, as written by
+ * deployment/make_secrets.py (see EccPoint_mult_twin_vartime).
+ * @param p_width IN -- Comb width of p_table, 2 to 7.
+ * @param p_message_hash IN -- The hash of the signed data.
+ * @param p_hash_size IN -- The size of p_message_hash in bytes.
+ * @param p_signature IN -- The signature values.
+ *
+ * @note Computes u1.G + u2.Q from the generator and key combs in variable
+ * time, which is safe since every input is public. Falls back to uECC_verify
+ * when uECC_COMB_WIDTH is 0.
+ */
+int uECC_verify_table(
+	const uECC_word_t *p_table, unsigned int p_width,
+	const uint8_t *p_message_hash, unsigned int p_hash_size,
+	const uint8_t *p_signature, uECC_Curve curve);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,11 @@
  *              all of the segments of the input; the order is important.
  *
  *              4) call tc_hmac_final to out put the tag.
+ *
+ *              When many tags are computed under one key, call
+ *              tc_hmac_set_midstate once instead of 1) and use
+ *              tc_hmac_init_midstate and tc_hmac_final_midstate in place of
+ *              2) and 4). The padded key blocks are then only hashed once.
  */
 
 #ifndef __TC_HMAC_H__
@@ -77,6 +82,14 @@ struct tc_hmac_state_struct {
 };
 typedef struct tc_hmac_state_struct *TCHmacState_t;
 
+struct tc_hmac_midstate_struct {
+	/* hash state after the key ^ ipad block */
+	struct tc_sha256_state_struct inner;
+	/* hash state after the key ^ opad block */
+	struct tc_sha256_state_struct outer;
+};
+typedef struct tc_hmac_midstate_struct *TCHmacMidstate_t;
+
 /**
  *  @brief HMAC set key procedure
  *  Configures ctx to use key
@@ -132,6 +145,53 @@ int tc_hmac_update(
  */
 int tc_hmac_final(uint8_t *tag, unsigned int taglen, TCHmacState_t ctx);
 
+/**
+ *  @brief HMAC midstate procedure
+ *  Hashes the inner and outer padded key blocks of key once, so that
+ *  tags under that key cost two compressions less
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if
+ *                mid == NULL or
+ *                key == NULL or
+ *                key_size == 0
+ *  @param mid IN/OUT -- the struct tc_hmac_midstate_struct to set
+ *  @param key IN -- the HMAC key
+ *  @param key_size IN -- the HMAC key size
+ */
+int tc_hmac_set_midstate(
+	TCHmacMidstate_t mid, const uint8_t *key, unsigned int key_size);
+
+/**
+ *  @brief HMAC init procedure from a midstate
+ *  Initializes ctx to begin the next HMAC operation under mid's key
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: ctx == NULL or mid == NULL
+ *  @param ctx IN/OUT -- struct tc_hmac_state_struct buffer to init
+ *  @param mid IN -- midstate set by tc_hmac_set_midstate
+ */
+int tc_hmac_init_midstate(
+	TCHmacState_t ctx, const struct tc_hmac_midstate_struct *mid);
+
+/**
+ *  @brief HMAC final procedure from a midstate
+ *  Writes the HMAC tag into the tag buffer
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if:
+ *                tag == NULL or
+ *                ctx == NULL or
+ *                mid == NULL or
+ *                taglen != TC_SHA256_DIGEST_SIZE
+ *  @note ctx is erased before exiting, mid is left for the next tag
+ *  @note Assumes ctx has been initialized by tc_hmac_init_midstate with
+ *  the same mid
+ *  @param tag IN/OUT -- buffer to receive computed HMAC tag
+ *  @param taglen IN -- size of tag in bytes
+ *  @param ctx IN/OUT -- the HMAC state for computing tag
+ *  @param mid IN -- midstate set by tc_hmac_set_midstate
+ */
+int tc_hmac_final_midstate(uint8_t *tag, unsigned int taglen,
+	TCHmacState_t ctx, const struct tc_hmac_midstate_struct *mid);
+
 #ifdef __cplusplus
 }
 #endif
@@ -104,6 +104,28 @@ int tc_sha256_init(TCSha256State_t s);
  */
 int tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
 
+/**
+ *  @brief SHA256 update procedure for repeated input
+ *  Hashes count back to back copies of the datalen bytes addressed by data
+ *  into state s, with the same result as count calls to tc_sha256_update
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if:
+ *                s == NULL,
+ *                data == NULL
+ *  @note Assumes s has been initialized by tc_sha256_init
+ *  @note The blocks of such input repeat every datalen / gcd(datalen, 64)
+ *        blocks. When that is at most 4 blocks their message schedules are
+ *        computed once and only the rounds run per block, otherwise this falls
+ *        back to calling tc_sha256_update
+ *  @note Keeps up to 4 schedules of 256 bytes each on the stack
+ *  @param s Sha256 state struct
+ *  @param data message to repeat
+ *  @param datalen length of message to repeat
+ *  @param count number of copies to hash
+ */
+int tc_sha256_update_repeated(
+	TCSha256State_t s, const uint8_t *data, size_t datalen, unsigned int count);
+
 /**
  *  @brief SHA256 final procedure
  *  Inserts the completed hash computation into digest
@@ -52,6 +52,25 @@ int tc_aes128_set_encrypt_key(TCAesKeySched_t s, const uint8_t *k) {
 	return TC_CRYPTO_SUCCESS;
 }
 
+/* Session whose key is in the engine, 0 if unknown */
+static const struct tc_aes_session_struct *loaded_session;
+
+static int load_key(const TCAesKeySched_t s) {
+	MXC_AES_SetExtKey(s->words, MXC_AES_128BITS);
+	return MXC_AES_Init() == E_NO_ERROR;
+}
+
+static int encrypt_blocks(
+	uint8_t *out, const uint8_t *in, unsigned int blocks) {
+	mxc_aes_req_t req;
+	req.length	   = blocks * ((Nk * Nb) / sizeof(uint32_t));
+	req.inputData  = (uint32_t *)in;
+	req.resultData = (uint32_t *)out;
+	req.keySize	   = MXC_AES_128BITS;
+	req.encryption = MXC_AES_ENCRYPT_EXT_KEY;
+	return MXC_AES_Encrypt(&req) == E_NO_ERROR;
+}
+
 int tc_aes_encrypt(uint8_t *out, uint8_t *in, const TCAesKeySched_t s) {
 	if (out == (uint8_t *)0) {
 		return TC_CRYPTO_FAIL;
@@ -61,15 +80,44 @@ int tc_aes_encrypt(uint8_t *out, uint8_t *in, const TCAesKeySched_t s) {
 		return TC_CRYPTO_FAIL;
 	}
 
-	mxc_aes_req_t req;
-	req.length	   = (Nk * Nb) / sizeof(uint32_t);
-	req.inputData  = (uint32_t *)in;
-	req.resultData = (uint32_t *)out;
-	req.keySize	   = MXC_AES_128BITS;
-	req.encryption = MXC_AES_ENCRYPT_EXT_KEY;
+	loaded_session = 0;
+	if (!load_key(s)) { return TC_CRYPTO_FAIL; }
+	if (!encrypt_blocks(out, in, 1)) { return TC_CRYPTO_FAIL; }
+	return TC_CRYPTO_SUCCESS;
+}
 
-	MXC_AES_SetExtKey(s->words, MXC_AES_128BITS);
-	if (MXC_AES_Init() != E_NO_ERROR) { return TC_CRYPTO_FAIL; }
-	if (MXC_AES_Encrypt(&req) != E_NO_ERROR) { return TC_CRYPTO_FAIL; }
+int tc_aes_session_begin(TCAesSession_t session, const uint8_t *k) {
+	if (session == (TCAesSession_t)0) { return TC_CRYPTO_FAIL; }
+
+	/* A session begun at the address of an old one needs its key loaded */
+	if (loaded_session == session) { loaded_session = 0; }
+	return tc_aes128_set_encrypt_key(&session->sched, k);
+}
+
+int tc_aes_session_encrypt(
+	TCAesSession_t session, uint8_t *out, const uint8_t *in,
+	unsigned int blocks) {
+	if (session == (TCAesSession_t)0) {
+		return TC_CRYPTO_FAIL;
+	} else if (out == (uint8_t *)0) {
+		return TC_CRYPTO_FAIL;
+	} else if (in == (const uint8_t *)0) {
+		return TC_CRYPTO_FAIL;
+	} else if (blocks == 0) {
+		return TC_CRYPTO_SUCCESS;
+	}
+
+	if (loaded_session != session) {
+		loaded_session = 0;
+		if (!load_key(&session->sched)) { return TC_CRYPTO_FAIL; }
+		loaded_session = session;
+	}
+	if (!encrypt_blocks(out, in, blocks)) { return TC_CRYPTO_FAIL; }
 	return TC_CRYPTO_SUCCESS;
 }
+
+void tc_aes_session_end(TCAesSession_t session) {
+	if (session == (TCAesSession_t)0) { return; }
+	if (loaded_session == session) { loaded_session = 0; }
+	_set_secure(&session->sched, 0, sizeof(session->sched));
+}
@@ -34,17 +34,44 @@
 #include <tinycrypt/ctr_mode.h>
 #include <tinycrypt/utils.h>
 
-int tc_ctr_mode(
+#include <string.h>
+
+/* Counter blocks encrypted per request to the AES engine */
+#define TC_CTR_BATCH_BLOCKS (8)
+
+/* out = in ^ keystream a word at a time, out may be the same buffer as in */
+static void xor_keystream(
+	uint8_t *out, const uint8_t *in, const uint32_t *keystream,
+	unsigned int len) {
+	unsigned int i;
+	uint32_t word;
+
+	/* memcpy keeps unaligned buffers legal, it compiles to plain loads and
+	stores where the core allows unaligned access */
+	for (i = 0; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, in + i, sizeof(word));
+		word ^= keystream[i / sizeof(word)];
+		memcpy(out + i, &word, sizeof(word));
+	}
+	for (; i < len; ++i) {
+		out[i] = in[i] ^ ((const uint8_t *)keystream)[i];
+	}
+}
+
+int tc_ctr_mode_session(
 	uint8_t *out, unsigned int outlen, const uint8_t *in, unsigned int inlen,
-	uint8_t *ctr, const TCAesKeySched_t sched) {
-	uint8_t buffer[TC_AES_BLOCK_SIZE];
+	uint8_t *ctr, TCAesSession_t session) {
+	uint32_t counters[TC_CTR_BATCH_BLOCKS * TC_AES_BLOCK_SIZE / 4];
+	uint32_t buffer[TC_CTR_BATCH_BLOCKS * TC_AES_BLOCK_SIZE / 4];
 	uint8_t nonce[TC_AES_BLOCK_SIZE];
 	unsigned int block_num;
+	unsigned int blocks;
+	unsigned int len;
 	unsigned int i;
 
 	/* input sanity check: */
 	if (out == (uint8_t *)0 || in == (uint8_t *)0 || ctr == (uint8_t *)0 ||
-		sched == (TCAesKeySched_t)0 || inlen == 0 || outlen == 0 ||
+		session == (TCAesSession_t)0 || inlen == 0 || outlen == 0 ||
 		outlen != inlen) {
 		return TC_CRYPTO_FAIL;
 	}
@@ -55,22 +82,37 @@ int tc_ctr_mode(
 	/* select the last 4 bytes of the nonce to be incremented */
 	block_num =
 		(nonce[12] << 24) | (nonce[13] << 16) | (nonce[14] << 8) | (nonce[15]);
-	for (i = 0; i < inlen; ++i) {
-		if ((i % (TC_AES_BLOCK_SIZE)) == 0) {
-			/* encrypt data using the current nonce */
-			if (tc_aes_encrypt(buffer, nonce, sched)) {
-				block_num++;
-				nonce[12] = (uint8_t)(block_num >> 24);
-				nonce[13] = (uint8_t)(block_num >> 16);
-				nonce[14] = (uint8_t)(block_num >> 8);
-				nonce[15] = (uint8_t)(block_num);
-			} else {
-				return TC_CRYPTO_FAIL;
-			}
+	while (inlen != 0) {
+		/* lay out the counter blocks this batch covers */
+		blocks = (inlen + TC_AES_BLOCK_SIZE - 1) / TC_AES_BLOCK_SIZE;
+		if (blocks > TC_CTR_BATCH_BLOCKS) { blocks = TC_CTR_BATCH_BLOCKS; }
+		for (i = 0; i < blocks; ++i) {
+			(void)_copy(
+				(uint8_t *)counters + i * TC_AES_BLOCK_SIZE, TC_AES_BLOCK_SIZE,
+				nonce, sizeof(nonce));
+			block_num++;
+			nonce[12] = (uint8_t)(block_num >> 24);
+			nonce[13] = (uint8_t)(block_num >> 16);
+			nonce[14] = (uint8_t)(block_num >> 8);
+			nonce[15] = (uint8_t)(block_num);
+		}
+
+		/* encrypt them all with the key already in the engine */
+		if (!tc_aes_session_encrypt(
+				session, (uint8_t *)buffer, (const uint8_t *)counters,
+				blocks)) {
+			return TC_CRYPTO_FAIL;
 		}
+
 		/* update the output */
-		*out++ = buffer[i % (TC_AES_BLOCK_SIZE)] ^ *in++;
+		len = blocks * TC_AES_BLOCK_SIZE;
+		if (len > inlen) { len = inlen; }
+		xor_keystream(out, in, buffer, len);
+		out += len;
+		in += len;
+		inlen -= len;
 	}
+	_set_secure(buffer, 0, sizeof(buffer));
 
 	/* update the counter */
 	ctr[12] = nonce[12];
@@ -80,3 +122,26 @@ int tc_ctr_mode(
 
 	return TC_CRYPTO_SUCCESS;
 }
+
+int tc_ctr_mode(
+	uint8_t *out, unsigned int outlen, const uint8_t *in, unsigned int inlen,
+	uint8_t *ctr, const TCAesKeySched_t sched) {
+	struct tc_aes_session_struct session;
+	uint8_t key[TC_AES_KEY_SIZE];
+	unsigned int i;
+	int result;
+
+	if (sched == (TCAesKeySched_t)0) { return TC_CRYPTO_FAIL; }
+
+	/* recover the key bytes tc_aes128_set_encrypt_key packed into words */
+	for (i = 0; i < TC_AES_KEY_SIZE; ++i) {
+		key[i] = (uint8_t)(sched->words[i / Nb] >> (8 * (i % Nb)));
+	}
+	result = tc_aes_session_begin(&session, key);
+	_set_secure(key, 0, sizeof(key));
+	if (result) {
+		result = tc_ctr_mode_session(out, outlen, in, inlen, ctr, &session);
+	}
+	tc_aes_session_end(&session);
+	return result;
+}
@@ -53,9 +53,12 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "ecc_comb_table.h"
+
 #include <string.h>
 #include <tinycrypt/ecc.h>
 #include <tinycrypt/ecc_platform_specific.h>
+#include <tinycrypt/utils.h>
 
 /* IMPORTANT: Make sure a cryptographically-secure PRNG is set and the platform
  * has access to enough entropy in order to feed the PRNG regularly. */
@@ -726,20 +729,435 @@ uECC_word_t regularize_k(
 	return carry;
 }
 
-uECC_word_t EccPoint_compute_public_key(
-	uECC_word_t *result, uECC_word_t *private_key, uECC_Curve curve) {
+/* (X1, Y1, Z1) += (x2, y2), Jacobian plus affine. The branches are only taken
+ * when the points are equal, opposite or infinite, which a valid recoding of
+ * a scalar in [1, n - 1] does not reach in practice. */
+static void add_mixed(
+	uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *Z1, const uECC_word_t *x2,
+	const uECC_word_t *y2, uECC_Curve curve) {
+	uECC_word_t t1[NUM_ECC_WORDS];
+	uECC_word_t t2[NUM_ECC_WORDS];
+	uECC_word_t t3[NUM_ECC_WORDS];
+	uECC_word_t t4[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	if (uECC_vli_isZero(Z1, num_words)) {
+		uECC_vli_set(X1, x2, num_words);
+		uECC_vli_set(Y1, y2, num_words);
+		uECC_vli_clear(Z1, num_words);
+		Z1[0] = 1;
+		return;
+	}
+
+	uECC_vli_modSquare_fast(t1, Z1, curve);			  /* t1 = z1^2 */
+	uECC_vli_modMult_fast(t2, t1, Z1, curve);		  /* t2 = z1^3 */
+	uECC_vli_modMult_fast(t1, t1, x2, curve);		  /* t1 = x2*z1^2 = U2 */
+	uECC_vli_modMult_fast(t2, t2, y2, curve);		  /* t2 = y2*z1^3 = S2 */
+	uECC_vli_modSub(t1, t1, X1, curve->p, num_words); /* t1 = U2 - x1 = H */
+	uECC_vli_modSub(t2, t2, Y1, curve->p, num_words); /* t2 = S2 - y1 = R */
+
+	if (uECC_vli_isZero(t1, num_words)) {
+		if (uECC_vli_isZero(t2, num_words)) {
+			uECC_vli_set(X1, x2, num_words);
+			uECC_vli_set(Y1, y2, num_words);
+			uECC_vli_clear(Z1, num_words);
+			Z1[0] = 1;
+			curve->double_jacobian(X1, Y1, Z1, curve);
+		} else {
+			uECC_vli_clear(Z1, num_words);
+		}
+		return;
+	}
+
+	uECC_vli_modMult_fast(Z1, Z1, t1, curve);		  /* z3 = z1*H */
+	uECC_vli_modSquare_fast(t3, t1, curve);			  /* t3 = H^2 */
+	uECC_vli_modMult_fast(t4, t3, t1, curve);		  /* t4 = H^3 */
+	uECC_vli_modMult_fast(t3, t3, X1, curve);		  /* t3 = x1*H^2 = V */
+	uECC_vli_modSquare_fast(X1, t2, curve);			  /* t1 = R^2 */
+	uECC_vli_modSub(X1, X1, t4, curve->p, num_words); /* x3 = R^2 - H^3 */
+	uECC_vli_modSub(X1, X1, t3, curve->p, num_words); /* ... - V */
+	uECC_vli_modSub(X1, X1, t3, curve->p, num_words); /* ... - V = x3 */
+	uECC_vli_modSub(t3, t3, X1, curve->p, num_words); /* t3 = V - x3 */
+	uECC_vli_modMult_fast(t3, t3, t2, curve);		  /* t3 = R*(V - x3) */
+	uECC_vli_modMult_fast(t4, t4, Y1, curve);		  /* t4 = y1*H^3 */
+	uECC_vli_modSub(Y1, t3, t4, curve->p, num_words); /* y3 */
+}
+
+#if uECC_COMB_WIDTH != 0
+
+/* Spacing of the comb teeth, in bits */
+#define COMB_D ((256 + uECC_COMB_WIDTH - 1) / uECC_COMB_WIDTH)
+#define COMB_POINTS (1 << (uECC_COMB_WIDTH - 1))
+
+/* Recodes an odd k into d + 1 odd digits of a width-tooth comb with teeth d
+ * bits apart (Hedabou, Pinel and Beneteau, as in mbedTLS). Bits 0 to
+ * width - 1 of digit i select the teeth at bits i, i + d, ... and bit 7 marks
+ * the digit as negative. With no zero digits the accumulator never passes
+ * through the point at infinity. */
+static void comb_recode(
+	uint8_t *digits, const uECC_word_t *k, unsigned int width, unsigned int d) {
+	uint8_t carry = 0;
+	uint8_t next_carry;
+	uint8_t adjust;
+	uECC_word_t word;
+	bitcount_t bit;
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0; i < d; ++i) {
+		digits[i] = 0;
+		for (j = 0; j < width; ++j) {
+			bit = (bitcount_t)(i + d * j);
+			if (bit < 256) {
+				word = k[bit >> uECC_WORD_BITS_SHIFT] >>
+					   (bit & uECC_WORD_BITS_MASK);
+				digits[i] |= (uint8_t)((word & 1) << j);
+			}
+		}
+	}
+	digits[d] = 0;
+
+	/* Make digits 1 to d odd without branching on them */
+	for (i = 1; i <= d; ++i) {
+		next_carry = digits[i] & carry;
+		digits[i] ^= carry;
+		carry = next_carry;
+
+		adjust = 1 - (digits[i] & 1);
+		carry |= digits[i] & (digits[i - 1] * adjust);
+		digits[i] ^= digits[i - 1] * adjust;
+		digits[i - 1] |= adjust << 7;
+	}
+}
+
+/* Sets y = p - y when cond is 1, leaves it when cond is 0 */
+static void cond_negate(uECC_word_t *y, uECC_word_t cond, uECC_Curve curve) {
+	uECC_word_t neg[NUM_ECC_WORDS];
+	uECC_word_t mask = -cond;
+	wordcount_t i;
+
+	uECC_vli_sub(neg, curve->p, y, curve->num_words);
+	for (i = 0; i < curve->num_words; ++i) {
+		y[i] = (y[i] & ~mask) | (neg[i] & mask);
+	}
+}
+
+/* Loads the table point for a recoded digit, reading every entry so that the
+ * access pattern does not depend on it */
+static void comb_select(
+	uECC_word_t *X, uECC_word_t *Y, uint8_t digit, uECC_Curve curve) {
+	uECC_word_t index = (digit & 0x7F) >> 1;
+	uECC_word_t mask;
+	uECC_word_t i;
+	wordcount_t j;
+
+	for (i = 0; i < COMB_POINTS; ++i) {
+		/* all ones when i == index */
+		mask = -(((i ^ index) - 1) >> (uECC_WORD_BITS - 1));
+		for (j = 0; j < NUM_ECC_WORDS; ++j) {
+			X[j] = (X[j] & ~mask) | (ecc_comb_table[i][j] & mask);
+			Y[j] = (Y[j] & ~mask) |
+				   (ecc_comb_table[i][j + NUM_ECC_WORDS] & mask);
+		}
+	}
+	cond_negate(Y, digit >> 7, curve);
+}
+
+void EccPoint_mult_base(
+	uECC_word_t *result, const uECC_word_t *scalar, uECC_Curve curve) {
+	uECC_word_t k[NUM_ECC_WORDS];
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[NUM_ECC_WORDS];
+	uECC_word_t Tx[NUM_ECC_WORDS];
+	uECC_word_t Ty[NUM_ECC_WORDS];
+	uint8_t digits[COMB_D + 1];
+	uECC_word_t even	  = !uECC_vli_testBit(scalar, 0);
+	wordcount_t num_words = curve->num_words;
+	int i;
+
+	/* The recoding needs an odd scalar, so an even one is replaced by
+	 * n - scalar and the result negated back at the end */
+	uECC_vli_sub(k, curve->n, scalar, NUM_ECC_WORDS);
+	for (i = 0; i < NUM_ECC_WORDS; ++i) {
+		k[i] = cond_set(k[i], scalar[i], even);
+	}
+	comb_recode(digits, k, uECC_COMB_WIDTH, COMB_D);
+
+	uECC_vli_clear(X, num_words);
+	uECC_vli_clear(Y, num_words);
+	comb_select(X, Y, digits[COMB_D], curve);
+
+	/* A random Z masks the accumulator's coordinates, and the final
+	 * inversion, against side-channel analysis */
+	if (uECC_generate_random_int(Tx, curve->p, num_words)) {
+		apply_z(X, Y, Tx, curve);
+		uECC_vli_set(Z, Tx, num_words);
+	} else {
+		uECC_vli_clear(Z, num_words);
+		Z[0] = 1;
+	}
+
+	for (i = COMB_D - 1; i >= 0; --i) {
+		curve->double_jacobian(X, Y, Z, curve);
+		comb_select(Tx, Ty, digits[i], curve);
+		add_mixed(X, Y, Z, Tx, Ty, curve);
+	}
+
+	uECC_vli_modInv(Z, Z, curve->p, num_words);
+	apply_z(X, Y, Z, curve);
+	cond_negate(Y, even, curve);
+
+	uECC_vli_set(result, X, num_words);
+	uECC_vli_set(result + num_words, Y, num_words);
+
+	_set_secure(k, 0, sizeof(k));
+	_set_secure(digits, 0, sizeof(digits));
+	_set_secure(Z, 0, sizeof(Z));
+}
+
+/* Recodes a public scalar for comb_add_vartime, replacing an even u by
+ * n - u. Returns whether the table points must be negated. */
+static uECC_word_t comb_recode_vartime(
+	uint8_t *digits, const uECC_word_t *u, unsigned int width, unsigned int d,
+	uECC_Curve curve) {
+	uECC_word_t k[NUM_ECC_WORDS];
+
+	if (uECC_vli_testBit(u, 0)) {
+		comb_recode(digits, u, width, d);
+		return 0;
+	}
+	uECC_vli_sub(k, curve->n, u, curve->num_words);
+	comb_recode(digits, k, width, d);
+	return 1;
+}
+
+/* Adds the table point of a recoded digit, looked up directly */
+static void comb_add_vartime(
+	uECC_word_t *X, uECC_word_t *Y, uECC_word_t *Z, const uECC_word_t *table,
+	uint8_t digit, uECC_word_t negate, uECC_Curve curve) {
+	const uECC_word_t *point =
+		table + ((digit & 0x7F) >> 1) * NUM_ECC_WORDS * 2;
+	uECC_word_t y[NUM_ECC_WORDS];
+
+	if ((digit >> 7) ^ negate) {
+		uECC_vli_sub(y, curve->p, point + NUM_ECC_WORDS, curve->num_words);
+	} else {
+		uECC_vli_set(y, point + NUM_ECC_WORDS, curve->num_words);
+	}
+	add_mixed(X, Y, Z, point, y, curve);
+}
+
+void EccPoint_mult_twin_vartime(
+	uECC_word_t *result, const uECC_word_t *u1, const uECC_word_t *u2,
+	const uECC_word_t *table, unsigned int width, uECC_Curve curve) {
+	/* A width-2 comb has the most digits */
+	uint8_t g_digits[COMB_D + 1];
+	uint8_t q_digits[128 + 1];
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	unsigned int q_d	  = (256 + width - 1) / width;
+	uECC_word_t use_g	  = !uECC_vli_isZero(u1, num_words);
+	uECC_word_t use_q	  = !uECC_vli_isZero(u2, num_words);
+	uECC_word_t negate_g  = 0;
+	uECC_word_t negate_q  = 0;
+	int i;
+
+	if (use_g) {
+		negate_g = comb_recode_vartime(
+			g_digits, u1, uECC_COMB_WIDTH, COMB_D, curve);
+	}
+	if (use_q) {
+		negate_q = comb_recode_vartime(q_digits, u2, width, q_d, curve);
+	}
+
+	/* Both combs share the doublings, starting from the point at infinity */
+	uECC_vli_clear(X, NUM_ECC_WORDS);
+	uECC_vli_clear(Y, NUM_ECC_WORDS);
+	uECC_vli_clear(Z, NUM_ECC_WORDS);
+	for (i = COMB_D > q_d ? COMB_D : q_d; i >= 0; --i) {
+		curve->double_jacobian(X, Y, Z, curve);
+		if (use_g && i <= COMB_D) {
+			comb_add_vartime(
+				X, Y, Z, ecc_comb_table[0], g_digits[i], negate_g, curve);
+		}
+		if (use_q && i <= (int)q_d) {
+			comb_add_vartime(X, Y, Z, table, q_digits[i], negate_q, curve);
+		}
+	}
+
+	uECC_vli_modInv(Z, Z, curve->p, num_words);
+	apply_z(X, Y, Z, curve);
+
+	uECC_vli_set(result, X, num_words);
+	uECC_vli_set(result + num_words, Y, num_words);
+}
+
+#else
+
+void EccPoint_mult_base(
+	uECC_word_t *result, const uECC_word_t *scalar, uECC_Curve curve) {
 	uECC_word_t tmp1[NUM_ECC_WORDS];
 	uECC_word_t tmp2[NUM_ECC_WORDS];
 	uECC_word_t *p2[2] = {tmp1, tmp2};
 	uECC_word_t carry;
 
-	/* Regularize the bitcount for the private key so that attackers cannot
+	/* Regularize the bitcount for the scalar so that attackers cannot
 	 * use a side channel attack to learn the number of leading zeros. */
-	carry = regularize_k(private_key, tmp1, tmp2, curve);
+	carry = regularize_k(scalar, tmp1, tmp2, curve);
 
 	EccPoint_mult(
 		result, curve->G, p2[!carry], 0, curve->num_n_bits + 1, curve);
 
+	_set_secure(tmp1, 0, sizeof(tmp1));
+	_set_secure(tmp2, 0, sizeof(tmp2));
+}
+
+#endif
+
+/* Width of the wNAF of Q in EccPoint_mult_twin_wnaf, and its odd multiples */
+#define WNAF_Q_WIDTH 5
+#define WNAF_Q_POINTS (1 << (WNAF_Q_WIDTH - 2))
+
+/* A scalar below 2^256 recodes to at most 257 digits */
+#define WNAF_DIGITS (NUM_ECC_WORDS * uECC_WORD_BITS + 1)
+
+/* Recodes a public scalar into its width-w NAF: every digit is 0 or odd with
+ * |digit| < 2^(width - 1), and a nonzero digit is followed by at least
+ * width - 1 zeros. Returns the number of digits, 0 for a zero scalar. */
+static bitcount_t wnaf_recode(
+	int8_t *digits, const uECC_word_t *u, unsigned int width) {
+	bitcount_t num_bits = uECC_vli_numBits(u, NUM_ECC_WORDS);
+	bitcount_t length	= 0;
+	bitcount_t bit		= 0;
+	int carry			= 0;
+	int window;
+	unsigned int i;
+
+	memset(digits, 0, WNAF_DIGITS);
+	while (bit < num_bits + 1) {
+		if ((bit < num_bits && uECC_vli_testBit(u, bit)) == !!carry) {
+			++bit;
+			continue;
+		}
+
+		window = carry;
+		for (i = 0; i < width && bit + (bitcount_t)i < num_bits; ++i) {
+			if (uECC_vli_testBit(u, bit + (bitcount_t)i)) { window += 1 << i; }
+		}
+
+		/* A window of 2^(width - 1) or more becomes negative, carrying one
+		 * into the bits above */
+		carry = window >> (width - 1);
+		digits[bit] = (int8_t)(window - (carry << width));
+		length		= bit + 1;
+		bit += (bitcount_t)width;
+	}
+	return length;
+}
+
+/* Adds digit * P for a nonzero wNAF digit, from the odd multiples of P */
+static void wnaf_add(
+	uECC_word_t *X, uECC_word_t *Y, uECC_word_t *Z, const uECC_word_t *table,
+	int8_t digit, uECC_Curve curve) {
+	const uECC_word_t *point =
+		table + ((digit < 0 ? -digit : digit) >> 1) * NUM_ECC_WORDS * 2;
+	uECC_word_t y[NUM_ECC_WORDS];
+
+	if (digit < 0) {
+		uECC_vli_sub(y, curve->p, point + NUM_ECC_WORDS, curve->num_words);
+	} else {
+		uECC_vli_set(y, point + NUM_ECC_WORDS, curve->num_words);
+	}
+	add_mixed(X, Y, Z, point, y, curve);
+}
+
+/* Fills table with Q, 3Q, ..., (2^(WNAF_Q_WIDTH - 1) - 1)Q in affine
+ * coordinates. 2Q is made affine for the mixed additions, then the sums share
+ * one inversion (Montgomery's trick). */
+static void wnaf_odd_multiples(
+	uECC_word_t (*table)[NUM_ECC_WORDS * 2], const uECC_word_t *point,
+	uECC_Curve curve) {
+	uECC_word_t Z[WNAF_Q_POINTS][NUM_ECC_WORDS];
+	uECC_word_t prefix[WNAF_Q_POINTS][NUM_ECC_WORDS];
+	uECC_word_t x2[NUM_ECC_WORDS];
+	uECC_word_t y2[NUM_ECC_WORDS];
+	uECC_word_t inverse[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	int i;
+
+	uECC_vli_set(x2, point, num_words);
+	uECC_vli_set(y2, point + num_words, num_words);
+	uECC_vli_clear(inverse, num_words);
+	inverse[0] = 1;
+	curve->double_jacobian(x2, y2, inverse, curve);
+	uECC_vli_modInv(inverse, inverse, curve->p, num_words);
+	apply_z(x2, y2, inverse, curve);
+
+	uECC_vli_set(table[0], point, num_words * 2);
+	uECC_vli_clear(Z[0], num_words);
+	Z[0][0] = 1;
+	uECC_vli_set(prefix[0], Z[0], num_words);
+	for (i = 1; i < WNAF_Q_POINTS; ++i) {
+		uECC_vli_set(table[i], table[i - 1], num_words * 2);
+		uECC_vli_set(Z[i], Z[i - 1], num_words);
+		add_mixed(table[i], table[i] + num_words, Z[i], x2, y2, curve);
+		uECC_vli_modMult_fast(prefix[i], prefix[i - 1], Z[i], curve);
+	}
+
+	/* inverse = 1 / (Z[1] ... Z[i]) going down, so that
+	 * inverse * prefix[i - 1] = 1 / Z[i] */
+	uECC_vli_modInv(inverse, prefix[WNAF_Q_POINTS - 1], curve->p, num_words);
+	for (i = WNAF_Q_POINTS - 1; i > 0; --i) {
+		uECC_vli_modMult_fast(x2, inverse, prefix[i - 1], curve);
+		uECC_vli_modMult_fast(inverse, inverse, Z[i], curve);
+		apply_z(table[i], table[i] + num_words, x2, curve);
+	}
+}
+
+void EccPoint_mult_twin_wnaf(
+	uECC_word_t *result, const uECC_word_t *u1, const uECC_word_t *u2,
+	const uECC_word_t *point, uECC_Curve curve) {
+	uECC_word_t table[WNAF_Q_POINTS][NUM_ECC_WORDS * 2];
+	int8_t g_digits[WNAF_DIGITS];
+	int8_t q_digits[WNAF_DIGITS];
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	bitcount_t g_length	  = wnaf_recode(g_digits, u1, WNAF_G_WIDTH);
+	bitcount_t q_length	  = wnaf_recode(q_digits, u2, WNAF_Q_WIDTH);
+	bitcount_t i;
+
+	if (q_length != 0) { wnaf_odd_multiples(table, point, curve); }
+
+	/* Both scalars share the doublings, starting from the point at infinity */
+	uECC_vli_clear(X, NUM_ECC_WORDS);
+	uECC_vli_clear(Y, NUM_ECC_WORDS);
+	uECC_vli_clear(Z, NUM_ECC_WORDS);
+	for (i = (g_length > q_length ? g_length : q_length) - 1; i >= 0; --i) {
+		curve->double_jacobian(X, Y, Z, curve);
+		if (g_digits[i] != 0) {
+			wnaf_add(X, Y, Z, ecc_wnaf_table[0], g_digits[i], curve);
+		}
+		if (q_digits[i] != 0) {
+			wnaf_add(X, Y, Z, table[0], q_digits[i], curve);
+		}
+	}
+
+	uECC_vli_modInv(Z, Z, curve->p, num_words);
+	apply_z(X, Y, Z, curve);
+
+	uECC_vli_set(result, X, num_words);
+	uECC_vli_set(result + num_words, Y, num_words);
+}
+
+uECC_word_t EccPoint_compute_public_key(
+	uECC_word_t *result, uECC_word_t *private_key, uECC_Curve curve) {
+	EccPoint_mult_base(result, private_key, curve);
+
 	if (EccPoint_isZero(result, curve)) { return 0; }
 	return 1;
 }
@@ -0,0 +1,666 @@
+/* ecc_comb_table.h - generated by ecc_comb_table.py, do not edit */
+
+#ifndef __TC_ECC_COMB_TABLE_H__
+#define __TC_ECC_COMB_TABLE_H__
+
+#include <tinycrypt/ecc.h>
+
+#if uECC_COMB_WIDTH == 2
+static const uECC_word_t ecc_comb_table[2][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B,
+	 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932,
+	 0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08,
+	 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3},
+};
+#elif uECC_COMB_WIDTH == 3
+static const uECC_word_t ecc_comb_table[4][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x7318188E, 0xAEC90264, 0xCA167099, 0x410BEC28,
+	 0x099C202B, 0xBF664D2F, 0x55FA625C, 0x13CCCA34,
+	 0x05421C0C, 0xAA84C231, 0x6CDB0D71, 0x6B647521,
+	 0xFB216A5E, 0xE90446B1, 0xAF46893D, 0x4B5BA5A5},
+	{0x016476EA, 0xC6E4B6D0, 0xD4EC2510, 0x71B9A7E5,
+	 0xCBE490D2, 0x1975B71E, 0xB52ACD25, 0xDF6B472F,
+	 0x784055EB, 0xF1738716, 0xB87D399E, 0xCCC7B0B3,
+	 0x1BB51119, 0x3C9A1337, 0xA88FD593, 0xB42639E1},
+	{0xF119B8CC, 0x546A08E7, 0x8AFC696A, 0x03B7D523,
+	 0x459F70B4, 0x0A896132, 0xA86A9116, 0x57A46257,
+	 0xBB314C65, 0xFAA56FEF, 0x74795C6D, 0xF4E61F40,
+	 0x437850D6, 0x1A3C5652, 0x6621EC11, 0x7C4B127D},
+};
+#elif uECC_COMB_WIDTH == 4
+static const uECC_word_t ecc_comb_table[8][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x097992AF, 0x93391CE2, 0x0D35F1FA, 0xE96C98FD,
+	 0x95E02789, 0xB257C0DE, 0x89D6726F, 0x300A4BBC,
+	 0xC08127A0, 0xAA54A291, 0xA9D806A5, 0x5BB1EEAD,
+	 0xFF1E3C6F, 0x7F1DDB25, 0xD09B4644, 0x72AAC7E0},
+	{0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B,
+	 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932,
+	 0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08,
+	 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3},
+	{0xFC5CDE01, 0xE48ECAFF, 0x0D715F26, 0x7CCD84E7,
+	 0xF43E4391, 0xA2E8F483, 0xB21141EA, 0xEB5D7745,
+	 0x731A3479, 0xCAC917E2, 0x2844B645, 0x85F22CFE,
+	 0x58006CEE, 0x0990E6A1, 0xDBECC17B, 0xEAFD72EB},
+	{0x677C8A3E, 0x2DF48C04, 0x0203A56B, 0x74E02F08,
+	 0xB8C7FEDB, 0x31855F7D, 0x72C9DDAD, 0x4E769E76,
+	 0xB824BBB0, 0xA4C36165, 0x3B9122A5, 0xFB9AE16F,
+	 0x06947281, 0x1EC00572, 0xDE830663, 0x42B99082},
+	{0xC31A3573, 0x7F991ED2, 0xD54FB496, 0x5B82DD5B,
+	 0x812FFCAE, 0x595C5220, 0x716B1287, 0x0C88BC4D,
+	 0x5F48ACA8, 0x3A57BF63, 0xDF2564F3, 0x7C8181F4,
+	 0x9C04E6AA, 0x18D1B5B3, 0xF3901DC6, 0xDD5DDEA3},
+	{0xA2582E7F, 0xD36B4789, 0x4EC39C28, 0x0D1A1014,
+	 0xEDBAD7A0, 0x663C62C3, 0x6F461DB9, 0x4052BF4B,
+	 0x188D25EB, 0x235A27C3, 0x99BFCC5B, 0xE724F339,
+	 0x71D70CC8, 0x862BE6BD, 0x90B0FC61, 0xFECF4D51},
+	{0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32,
+	 0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4,
+	 0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404,
+	 0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540},
+};
+#elif uECC_COMB_WIDTH == 5
+static const uECC_word_t ecc_comb_table[16][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x04BAC870, 0xF7D24BB7, 0x3A23C6AB, 0x593A09A0,
+	 0xF94C9D1D, 0xDFCC2358, 0x297BED02, 0x3CFA0F87,
+	 0x40F26940, 0xCE98A30B, 0x0248A8AF, 0x62121C0D,
+	 0x8309AF9B, 0xA758AA80, 0x70BE12C6, 0xE4E37694},
+	{0x86EF7D7D, 0xDD37E3FF, 0x088B86DB, 0xF6D77C27,
+	 0x254C5491, 0x28FE9A4F, 0x6DF0FD5E, 0xD6690337,
+	 0xADDAD596, 0x9FF04992, 0x9E4373F9, 0xF3D1A7AF,
+	 0xDF074167, 0xA13E9578, 0xE6D13D22, 0x20E2A53C},
+	{0x525D6ABF, 0xAEBFD735, 0x96BEA25A, 0xC302F8F4,
+	 0x544920A4, 0xDB82B3EA, 0x02EADB2E, 0x621C75D1,
+	 0x9EF485F0, 0x8939DC4C, 0x57C46D63, 0x225D03D8,
+	 0x522D7F70, 0x4FDAC96F, 0xB4FA649D, 0xD7C4A4FE},
+	{0xC0B9372A, 0x8BC659AA, 0xEDD9583F, 0xF7659958,
+	 0x8C267D88, 0x9F05F94A, 0xC99A739D, 0x00DC46E7,
+	 0xDF55D0F2, 0x4AF50A00, 0x8156BF6A, 0xB5EB202D,
+	 0x5228C111, 0x40D1E3AB, 0x45793424, 0x0312A557},
+	{0x7EB8CFEE, 0x8D9692F7, 0x0D8C013D, 0x05E3F223,
+	 0x84E32E59, 0x76347A52, 0x15B0A1E5, 0x3C53E290,
+	 0xFAE798D4, 0x538B7DA5, 0x00D23591, 0x1B9F1BD1,
+	 0x9A08693F, 0x11A9F072, 0x140EFEB3, 0xD30E7CDA},
+	{0xF8E8F683, 0x6DFCF787, 0x3F7FBE90, 0x13D72B7A,
+	 0x2DF232CF, 0xFD426D94, 0x5FE39AAD, 0xED84BB42,
+	 0x732995FC, 0x023E67A1, 0x355430E3, 0x67DD0A8E,
+	 0x97A1D703, 0x0CF83B61, 0x583C33F2, 0xA3233455},
+	{0x5F165D99, 0xCEBBBC7B, 0x8A4EEE61, 0x50CC51C1,
+	 0x1B4D0D1F, 0xB31D2353, 0x66382ADA, 0x95E18452,
+	 0x0A839B5B, 0xACAD4F81, 0x4142FF0F, 0xA0A2A96E,
+	 0x1F4FA12F, 0x3EAA8289, 0x6B0FB8F3, 0x68D68C8F},
+	{0x51BBB3F1, 0x9311A269, 0x8D0F4F65, 0xE80F26BD,
+	 0x6BECCBB9, 0x9D3DC334, 0x101E5DE4, 0x54E244D5,
+	 0xF1B19E28, 0xB3AD4C6E, 0x58C2E3B7, 0x4334FBC0,
+	 0x35DF9C25, 0x19BD4107, 0xEC106EB6, 0xD6BBEC0E},
+	{0x3FEFCFC8, 0xE8881A83, 0xB9B5290B, 0xAEA3C9E0,
+	 0x771E4688, 0x10B37ECD, 0xD4D021B6, 0xEE0816A3,
+	 0xB3A8CAA1, 0x8E9929BF, 0xC105F2D1, 0x48915DCF,
+	 0xDB49019F, 0x3A5FDF82, 0xAD9006E1, 0xC4A438E3},
+	{0xE83AD2C9, 0x5D6DC503, 0xAED035BE, 0xCA9F7A1D,
+	 0xCBD21E33, 0x552788AC, 0xE09CB9F0, 0x8699DD31,
+	 0x329BF961, 0x38584196, 0xB82A5AF9, 0x4CB20E96,
+	 0xC72C78C1, 0x24199908, 0xE92859B7, 0x16E65484},
+	{0xDB3038DD, 0xA20A2C70, 0xE99D5C7C, 0x5F0B46D5,
+	 0x4B600B83, 0xC9B97D37, 0x3DF3245E, 0x186C7F79,
+	 0x4F1CE57F, 0x2AF72460, 0x91E2D8ED, 0x9249897F,
+	 0x8D2EA797, 0x8139B36A, 0x9AB58913, 0x9C428DB8},
+	{0x4BE6458D, 0x1F1E4F3F, 0x595E6547, 0x5F72CC22,
+	 0x271A93F1, 0x5BC5341E, 0x58A5F263, 0xC62E155C,
+	 0x58BA7FF4, 0x5F6F845A, 0x7E36A6AD, 0x67E1F7DC,
+	 0xEEAA4D04, 0xD33A7657, 0x18267E4E, 0xFF9F2322},
+	{0xC7644C1D, 0xE33F0255, 0xBB9002D8, 0x4030ECC3,
+	 0xF4646F9F, 0xA4486916, 0x959C44FA, 0x5E677D0C,
+	 0xD88B9144, 0xE2E7D7D0, 0x6248F91F, 0x5D93A86F,
+	 0x02993AEA, 0xE33D0BD5, 0x3100D31E, 0x449F0CE6},
+	{0xFDAAB256, 0x52DF1588, 0x3127354C, 0x68C0CD44,
+	 0xA591F853, 0x2A849471, 0x93D0CB92, 0xE4DA88E9,
+	 0x1639C624, 0x6D1EA35D, 0x263707BA, 0x60FE2A36,
+	 0xD0F3BC51, 0x97FC50DE, 0x10062E80, 0xF7FA4D15},
+	{0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0,
+	 0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194,
+	 0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4,
+	 0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE},
+};
+#elif uECC_COMB_WIDTH == 6
+static const uECC_word_t ecc_comb_table[32][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x5A1C3FB1, 0x59DB167C, 0xBF318EB2, 0x98B3CE2A,
+	 0xD2BC2FA6, 0x2DF1C41E, 0x6ED1B2AF, 0xEFCC2C43,
+	 0x97B25513, 0x17FE07F1, 0x3734A589, 0x46824533,
+	 0xED34F543, 0xA5384A77, 0x8D9F3863, 0xF3684F9C},
+	{0x7318188E, 0xAEC90264, 0xCA167099, 0x410BEC28,
+	 0x099C202B, 0xBF664D2F, 0x55FA625C, 0x13CCCA34,
+	 0x05421C0C, 0xAA84C231, 0x6CDB0D71, 0x6B647521,
+	 0xFB216A5E, 0xE90446B1, 0xAF46893D, 0x4B5BA5A5},
+	{0xCBDB1C78, 0xD3B22809, 0x30F6CDA4, 0x5591C8EB,
+	 0xBFE80F8B, 0xB6E28740, 0x40E7E7E7, 0x0F74342A,
+	 0x351C51F2, 0xD2968E87, 0xF5E17B5E, 0x65C5C581,
+	 0x9D994E2E, 0x6F58F02A, 0xF5C1EC07, 0x531C0B00},
+	{0x8B21AA51, 0x2B52C47D, 0x5A7E870D, 0x0F503629,
+	 0x88B45127, 0xBAA92814, 0xC402E050, 0x27D6451E,
+	 0x5567432D, 0x5C96EC14, 0x0F4150C7, 0xCDEB9829,
+	 0xCDEEF566, 0x5D91740C, 0x1BE9E583, 0x2A58FA5E},
+	{0x2195A979, 0x73B7C550, 0xB8DD5813, 0x2D7ED474,
+	 0xE104E9AC, 0xC0B9ECD2, 0xA2BD0ED8, 0xDC90D975,
+	 0x4DD6EB2E, 0x9FB55203, 0xC01DFDE8, 0x50D554BB,
+	 0xF0977A30, 0x4CFD3277, 0x815374C4, 0xC87CE232},
+	{0x1703406D, 0xCB4DC35B, 0x75DAC54C, 0x4FD3AFC9,
+	 0x29F02878, 0x112321EB, 0xAD6B225F, 0xAFB18D2F,
+	 0xF1776A67, 0xDDF58273, 0xF6B96C2F, 0x96889755,
+	 0x22208FFB, 0x31A8D663, 0xFCCA4877, 0x5ED81C10},
+	{0x336AAF40, 0x2DC61E1B, 0x4251F5B7, 0x897E87BD,
+	 0x6511B370, 0x2FB32023, 0x2341F499, 0x460FA9CF,
+	 0xCBAF01A7, 0x03E63B79, 0x44157434, 0x937E123F,
+	 0x809E4A1A, 0x9D59226E, 0x41775E62, 0x18D6F63A},
+	{0x016476EA, 0xC6E4B6D0, 0xD4EC2510, 0x71B9A7E5,
+	 0xCBE490D2, 0x1975B71E, 0xB52ACD25, 0xDF6B472F,
+	 0x784055EB, 0xF1738716, 0xB87D399E, 0xCCC7B0B3,
+	 0x1BB51119, 0x3C9A1337, 0xA88FD593, 0xB42639E1},
+	{0x20B4D697, 0x41E94206, 0x29FA0DF9, 0xA10FD0D9,
+	 0x76022C38, 0xF11EB0A7, 0xA5621C63, 0xFFCB7DDC,
+	 0x0927965A, 0x24E37B1B, 0xBD2C199E, 0x8D9FC102,
+	 0x907F3F85, 0x862DE75E, 0x5A9C778E, 0xD3985129},
+	{0xF119B8CC, 0x546A08E7, 0x8AFC696A, 0x03B7D523,
+	 0x459F70B4, 0x0A896132, 0xA86A9116, 0x57A46257,
+	 0xBB314C65, 0xFAA56FEF, 0x74795C6D, 0xF4E61F40,
+	 0x437850D6, 0x1A3C5652, 0x6621EC11, 0x7C4B127D},
+	{0x56C8815E, 0xF41E0307, 0x7D37A2F1, 0xBAF647E3,
+	 0xFEFAFBF5, 0x7791EB36, 0x35B7F606, 0x158262FB,
+	 0x32DCE9E5, 0xF6C32255, 0x361B4780, 0x6C7CD4CE,
+	 0x3F85288F, 0xE5BE5E70, 0xC98E624A, 0x4C281AA3},
+	{0x4D6A3DEF, 0x5B2911DD, 0xB96008F1, 0x4BEDD07C,
+	 0xE36E7D64, 0xEE748A6F, 0x4BBF5CF4, 0xBFC49934,
+	 0x8E74750F, 0x55C6F62D, 0x48919902, 0x22639F87,
+	 0x958A248F, 0xFA01AA94, 0xED51AA40, 0x2743AE8A},
+	{0x86EB7815, 0x9CDDA821, 0xCE413265, 0x8C003612,
+	 0x91B577F5, 0x8BCE1FAB, 0x488F730C, 0x0F3F29FF,
+	 0xE6960D55, 0xEBB08063, 0xAECBF467, 0x1A9699E2,
+	 0x4CE5761B, 0x6B1564A4, 0x81382996, 0x08F00EA5},
+	{0x70514A21, 0x0D17FF39, 0xDADD80EE, 0xD2A7B5BA,
+	 0x8126C8C4, 0x941E33C3, 0x1D57C1DE, 0xB9E156D0,
+	 0xEA8105AD, 0x220D500D, 0x0202F3AE, 0x6A2AA462,
+	 0x3DC96356, 0x450056AB, 0x452142C3, 0x506AB6AA},
+	{0xC05131CD, 0xF197735B, 0x22BEB567, 0x05650768,
+	 0xF7F55B1F, 0xDBF2B189, 0x132C2614, 0xAA144C82,
+	 0xB3822251, 0xF41CBE14, 0xFFD0AFBE, 0xB1CE72B2,
+	 0x844743FA, 0x01A14D18, 0x923739B8, 0xC1D89FE3},
+	{0x5F3F5B80, 0x12416A5C, 0xDA522422, 0x58E903DB,
+	 0x4291867E, 0x18CC80F1, 0x7A152C2B, 0xB2035CF8,
+	 0x95C80EDE, 0x71125691, 0xAF97C5B0, 0xBFE02568,
+	 0x8A14E493, 0x603E1DC5, 0x749680DE, 0xF12F359C},
+	{0xFEA77B0C, 0x40429D1B, 0x595E9A31, 0x4651A4DC,
+	 0xE712693A, 0x8900AAB1, 0x84BF612D, 0x90EA7767,
+	 0x0D02F2B6, 0xBDD10425, 0xFB4D594F, 0xF5583BCC,
+	 0x5BA7B6A1, 0x75754462, 0x101E86F4, 0xD1A321D3},
+	{0xE62DA069, 0x6890B26C, 0x7C586265, 0xA5702319,
+	 0x865672AB, 0xE64E19BF, 0xA07D9893, 0xA66503F5,
+	 0x21FE4743, 0xE4DEB7C0, 0x7D7100BE, 0x3BAE847D,
+	 0xE17B1D29, 0x1769FCA7, 0x320AFC60, 0xADBA60EC},
+	{0xC4E48158, 0xA3C9D614, 0xAE8FC508, 0xB26B4A98,
+	 0x38B68E18, 0x44EF8BE0, 0xDB271FCD, 0xBE9CF596,
+	 0x8E6F95AD, 0x737B653E, 0x9B9E4D0A, 0x73DBE6FF,
+	 0xA4139F59, 0x4B772A8C, 0x66C67E8A, 0xA1F335E5},
+	{0xF77CF152, 0xC0B161FB, 0x8CE30043, 0x243C4FED,
+	 0x050E20DF, 0xB1B4A2D0, 0xC34999AE, 0x5A61A286,
+	 0x70214EB7, 0x8C7BAF68, 0xF2C261FE, 0x975BCA7D,
+	 0x1ED91AE8, 0x03C6DF31, 0xA1380D38, 0xE8CFAAAD},
+	{0x966D28DD, 0xC79E3178, 0x89F8A2C1, 0x67BA8686,
+	 0x4ACF8D42, 0xAF1F9C6D, 0xE0847F7D, 0x2D2B4273,
+	 0x69130CEC, 0x1D9E1A90, 0x9383E7B5, 0x95CB10FD,
+	 0x44CC71AE, 0x73438A26, 0x1EE4EA49, 0x37EAEB10},
+	{0xD84A37DE, 0x1C12B5CB, 0xC7B1EA1A, 0x56D66DB4,
+	 0x2CE31E9A, 0x852BE420, 0xE40FAF48, 0x17BE9C2D,
+	 0x38CC8797, 0x735B3CCB, 0x34B1093E, 0x1F8D9D80,
+	 0xE75B81C0, 0xD8CC6E86, 0x3FDBE697, 0x6914BF94},
+	{0x00B16F35, 0x54B44D33, 0x002D5707, 0x59988EF3,
+	 0xD0494F94, 0x256FE1EB, 0x7F710DE4, 0xAEF84169,
+	 0x8BD49604, 0xCA38FB1F, 0xBFA0B15C, 0xAEC9DAAE,
+	 0x642CF6DD, 0x1551365E, 0x160E8FFF, 0x75B8B0FA},
+	{0xEDAB9CB9, 0x6033D113, 0xE69D45EE, 0x1DF87BA3,
+	 0xE4D65A03, 0x93436236, 0x3F98A508, 0x5893F6F9,
+	 0xAAD54FAB, 0xB3832E15, 0x6BC7365E, 0x3277FF0D,
+	 0x200C4FB8, 0xE8301118, 0xD4E9384D, 0x26E471BC},
+	{0xC52427D8, 0x3276C5A4, 0xF5A34B64, 0x66958243,
+	 0xF36E0D92, 0x04166798, 0xC6E9E63F, 0x43E33927,
+	 0xF0CA8D2B, 0x899AED76, 0x0AF50DD8, 0x43B89CDE,
+	 0x5951E13B, 0x805EA21E, 0x28413043, 0xE210DAA4},
+	{0x0758035B, 0xCE46A165, 0xE070A0C9, 0xB33DF1AD,
+	 0x686934C9, 0xBF01FB38, 0xF0F16ED0, 0x1CBA6257,
+	 0xEE93409C, 0xE538A9B6, 0x4A6B38DA, 0xD82429A1,
+	 0xA5C215B1, 0x1488770D, 0x891D7658, 0x4ADE1F8E},
+	{0x27ADE63F, 0xFE702B4B, 0xA105673A, 0x5DF11A33,
+	 0xA362B9CE, 0x0D33CB80, 0x855BB209, 0xA7BB42F5,
+	 0xC95FE575, 0xFDCC6096, 0x2351DEC6, 0xFF0E08D7,
+	 0xBB6A5B28, 0xA3323FF5, 0x89F7A2AB, 0x2CAA2DAE},
+	{0x2DA7EB49, 0x2096D676, 0xFB775E41, 0x6E04768E,
+	 0xAF24F76C, 0xC3349C3D, 0xDE0C90F6, 0xE6DB6CCA,
+	 0xA416FD87, 0x98AA01F5, 0x781EC427, 0x84C3270B,
+	 0x021034B2, 0x37680F04, 0x654BF735, 0xEB90FE3C},
+	{0xB3571976, 0x8E35BF16, 0x346864E7, 0xE2EB0C63,
+	 0x7E9B6C7F, 0x2B7B57E0, 0x70B35A98, 0x3157CF6F,
+	 0x5AC49EA5, 0xFEC24C14, 0x6B1A32AE, 0xC20C5690,
+	 0x345FA335, 0xEAEF7B4E, 0x4077475F, 0xB4C9655D},
+	{0xFCF866B9, 0xF3F4E3FE, 0xE18B0AD5, 0x152A0807,
+	 0x1B9B2E7B, 0x2EC4C706, 0xDADD006F, 0x41D7E92B,
+	 0x1D4B6EF7, 0xFF0A8A79, 0xB2AA2F47, 0x02344DFF,
+	 0x357A0681, 0x1726D704, 0xC1BC85F4, 0x4CE6BB77},
+	{0xAFCC2BEF, 0xB9E437F4, 0x3ADA2B53, 0x4F1FB2D6,
+	 0xBB580C9A, 0xE6C0E12D, 0x33C7546D, 0x25183734,
+	 0xBFD92FB9, 0xAB12D90F, 0xA185AE46, 0x2CB9B9B3,
+	 0x9CE6F49F, 0x2A0C7A7E, 0xB48F21F2, 0x531F307F},
+};
+#elif uECC_COMB_WIDTH == 7
+static const uECC_word_t ecc_comb_table[64][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0x66D4E2BC, 0x58BDFA8E, 0x9B1F858B, 0x8F77A569,
+	 0xB6FB1070, 0xFEEC5805, 0x9D64351F, 0x1CDF701E,
+	 0x2783BA45, 0xBA427042, 0xF7665B19, 0x54B09CE3,
+	 0x8C656862, 0x0BCA94AA, 0xC43C6B76, 0xC37D7F62},
+	{0x717A0611, 0x49F68919, 0x28F17701, 0x3976A296,
+	 0x5DF3CB83, 0x09CDEB9D, 0xCFB6448F, 0x183C55CC,
+	 0x70EFBCE8, 0x1B6D1B3F, 0x167E6228, 0x79FF4484,
+	 0xF6290B34, 0xFA41C36F, 0xE5B76B65, 0xEAEF1249},
+	{0xA97AB1EC, 0xB41B1D2D, 0x83CEBA2B, 0xB7917784,
+	 0x8D2850DE, 0x45FBEC0D, 0x3A6376B1, 0x7A20B5FD,
+	 0x685F8D97, 0xB2D21722, 0x22EE2184, 0xA073F8D6,
+	 0x3F46A374, 0x97CC8951, 0x175FADAD, 0x477F1D41},
+	{0xFC602827, 0x16305832, 0x55C1B372, 0x08E0B379,
+	 0x2AA3A67B, 0x7DCB57F7, 0x4FB0F09A, 0x5FF1B63D,
+	 0x1C854F7F, 0x370A4636, 0x2830F455, 0xD837F9A7,
+	 0xA2D58ACE, 0xAA0D33F2, 0xC490B3F0, 0x562E4757},
+	{0x79023D63, 0x8157FD7F, 0x056DE78B, 0x7F9603BF,
+	 0x214DF921, 0x3790A889, 0x9A3A5A1A, 0xA20CCB8E,
+	 0xF75787B1, 0x9BEB594B, 0x86119C08, 0xDD806F4F,
+	 0xD8071364, 0x6D3A51E8, 0x157A43AA, 0xFCAA5616},
+	{0x375C4AEB, 0x517CAC57, 0x4FF16BD2, 0x352499BC,
+	 0xB0D265E8, 0x2C1B1032, 0xF4174EA4, 0x2DB3B36B,
+	 0x3315C1A4, 0x626C820D, 0xF851DCC4, 0xC0E3CE26,
+	 0x8E9EE4E8, 0x274F1DFC, 0xE6039E6E, 0x3030E74E},
+	{0x3488885F, 0xD7BB0D96, 0xD505F8F6, 0xBE034BEF,
+	 0x32ACF6CC, 0x64CD8F6E, 0xAB84B50F, 0x915F8E4C,
+	 0x2DC91BD4, 0x0642AE38, 0xAA59AC9E, 0x966C989E,
+	 0xFC41C571, 0x2D5EADC1, 0xEF9D42CB, 0x43F8DA79},
+	{0xCA5E59AD, 0x276CB26D, 0x13041DE1, 0xB688AAFB,
+	 0x143BCF73, 0x2F7D2235, 0x5977E774, 0xA91C7497,
+	 0x2F9D1AC9, 0xF60DEF81, 0x86E16EE7, 0x0C67D5EA,
+	 0x4730F8D1, 0x85DD2DD9, 0x3B61EF8A, 0xF59A5DD7},
+	{0x7595EFCF, 0xACC48903, 0x6A99CFD4, 0x4A5B7171,
+	 0xFEDC0578, 0x85BBF7ED, 0xF5EC256B, 0x1DB5D227,
+	 0xFFE44B30, 0x6ED1BE54, 0x7C5E5A75, 0xB04D6820,
+	 0x2AEF51DA, 0xA8FA90CA, 0x30239A66, 0x9F26C31D},
+	{0x80A1C3B9, 0xFBE83618, 0x1401C46D, 0x9F95B0AE,
+	 0x4A76B0F7, 0x6C6A8CD0, 0x99159BDB, 0x5B246B29,
+	 0x3AFF0D3D, 0x6E68971A, 0xFBB6D2F9, 0x2B046407,
+	 0x73AB7A26, 0xED8E3FF4, 0x9F05A12E, 0xB1CD0623},
+	{0x4440B2B4, 0x0F0D0AC3, 0xBC2466EB, 0x6E5BABC4,
+	 0x6E87AE5D, 0x75D997E5, 0xCA353D97, 0x7B2A3707,
+	 0xD2EF2F0D, 0x428039E7, 0xCC91E514, 0x48DB0CF6,
+	 0xA685B5F5, 0xE15FAAE7, 0xA42752CC, 0x71503B9E},
+	{0xFB261AA1, 0x2C69AFA5, 0xD0C7A52C, 0xEAD7EBFE,
+	 0xB646AA17, 0x3DAA5F8C, 0x57A729FE, 0xD1F26B51,
+	 0x4F4A595F, 0x2A8C2A34, 0x9369F6B9, 0x85C3E8CE,
+	 0xD4C3B33D, 0x1F710903, 0x48FC1423, 0x48F60972},
+	{0xA28F8357, 0x84A6754D, 0xB1E5C11C, 0xA888DBCD,
+	 0x14BC3317, 0x04F6D9B1, 0xDDF0882E, 0x33F6E36F,
+	 0xAE7F395C, 0x51F4AFB5, 0x52720C58, 0xC20ECF52,
+	 0xDF7E9952, 0xD7311E4F, 0xDF4F8977, 0x9E193AA7},
+	{0x7DBCD045, 0xCC5C715C, 0x6AC5BE08, 0xCB2A442F,
+	 0x1A304FD3, 0x6FC337A4, 0xDE391401, 0xBE2B31DE,
+	 0x4D3D27A8, 0x5204390D, 0x8E70B527, 0xFEFC9AAB,
+	 0xC7DF79DF, 0x3F9B7392, 0x2C667970, 0x90EBA9BE},
+	{0xE76A12CC, 0x28A277C4, 0x3EC44C95, 0x53BFED84,
+	 0x20359286, 0x2AED6811, 0x752E012E, 0x041D2CA5,
+	 0x717476E9, 0x881723B2, 0xA64A3FE6, 0x60C9EF6E,
+	 0x62DD41E9, 0x69F0A26E, 0xB74FBF79, 0x19D42E8C},
+	{0xA0D850BD, 0x021D982A, 0x684F68EB, 0xAD607931,
+	 0xDDF6FDCD, 0x17C84C69, 0xEB3F4758, 0x653DAEF9,
+	 0xEF152B37, 0x3DEAA6AB, 0xF69B2DAB, 0xDE7FDABE,
+	 0x41754FA5, 0xDD7206B0, 0xF9E0180C, 0x2DC979F8},
+	{0xB98F8D22, 0xCAA9300D, 0xB24F88EC, 0x2E1DD47B,
+	 0xB72A2A93, 0x9FDBFF50, 0x5D9D5271, 0x8970F0D5,
+	 0x7C42A345, 0x268F3BCC, 0xDF9F7224, 0xE4CC1179,
+	 0x56ABD051, 0x099CA8CA, 0x85B95353, 0x2FB9E599},
+	{0x31386B9A, 0x7432A568, 0x6B22F44B, 0x5EAA5D28,
+	 0xBCEC4DBF, 0xF12FAA49, 0x93B62C32, 0x3D791330,
+	 0x7CAA6385, 0x211CC054, 0xC3144294, 0x7E56D9B4,
+	 0x6ED5EBB8, 0x06792E13, 0xCA8404B5, 0x692FDF6E},
+	{0xC047EC08, 0x93FAA7B8, 0x2A564E48, 0x75D93A3C,
+	 0x8E40783E, 0x775A5850, 0xA5723C39, 0x0EE8D540,
+	 0xAD05F672, 0xD65AC60E, 0x2F2ADA52, 0x17148401,
+	 0xA1935DE7, 0xFD4C754F, 0x061A7C82, 0xFFAC4BD5},
+	{0x1A6FB1BE, 0x3E9D81C0, 0x8653C8E3, 0xD9A803ED,
+	 0x8E49EFB2, 0x18C67E5A, 0xB9F2AC55, 0x9B3D25F7,
+	 0xA2A90E50, 0x313BA23D, 0x810690BC, 0x1C09A37E,
+	 0x18B63EDA, 0x0FBE0345, 0x6496F26C, 0x36D4E308},
+	{0x49EBC3ED, 0x1245D890, 0xBFD91A7E, 0x3B98C994,
+	 0x64FF8B35, 0xF35B885E, 0xF355FFEC, 0x96660A48,
+	 0x51BBF899, 0x247A9DAE, 0x4F36401B, 0x16B0668B,
+	 0xFC6D187C, 0xB213C88B, 0x7D325507, 0x5501F3E4},
+	{0x7B7D8DD2, 0xDDD4EB0F, 0x5547DFD0, 0x3F78F6BE,
+	 0x604C7C2E, 0x3A6DB541, 0x6F2F1D36, 0x10CA9A6F,
+	 0x27AFC848, 0x174DE235, 0x85E89CD7, 0x7D7A044F,
+	 0xED532118, 0x378042B8, 0x1F51FA9F, 0x1D119A38},
+	{0x2545C3F6, 0x01957C79, 0x59CC90D6, 0x4DD11BBE,
+	 0x61AC362B, 0xAE526077, 0xCDC0A72D, 0x0D0CD0C5,
+	 0x9E4947D7, 0x71C841C9, 0xE05A7686, 0x5DB7EA1A,
+	 0x88BBDA1E, 0xF2D51753, 0x110C6D73, 0xDD0DA9AA},
+	{0x1F5D4F2E, 0x24BD92E1, 0xED3A7FE3, 0x33EED23D,
+	 0x9921BCAA, 0x30EF3276, 0x6A190783, 0xFE1E1720,
+	 0xD0B38FC1, 0xA74BBFCA, 0x26238537, 0x6AD56FBD,
+	 0xA24DCE0D, 0x1453C53F, 0x572E13F3, 0xB8D66F8D},
+	{0x6DDBA35B, 0x55135FA9, 0x0C99FEBA, 0x3C4793C2,
+	 0x65CD5361, 0xA6984DED, 0x23F804FE, 0xC1E9DF72,
+	 0x34782A6F, 0x5161A44D, 0x8F580E37, 0xC2B44296,
+	 0x677F245D, 0xBB2456CA, 0x6BCD8A73, 0xF8D4093F},
+	{0x80C658C5, 0xA9D5F262, 0xEDA7045C, 0x71C15750,
+	 0xC92A5FF3, 0x54F4299B, 0xE7FE3BE8, 0x607D7C03,
+	 0xE3354062, 0x1EA184FE, 0x665A39B1, 0x7D676238,
+	 0x706292B1, 0x45280843, 0x12DAD77F, 0xF5FB0200},
+	{0x75A86757, 0xE1101BF7, 0xC58780F2, 0x3F34B01C,
+	 0x8A62312E, 0x0FD080F8, 0x693BCB40, 0xB0D3CC7E,
+	 0x990247BB, 0xE63BA9C1, 0x6F1A0521, 0x097DD003,
+	 0x4BA1CDF9, 0xBA8E4A48, 0x7E38F247, 0xB8E2EB26},
+	{0x3E929CA8, 0x9CFCAE87, 0xE8BD2F23, 0xF2DA271F,
+	 0x961D7E30, 0x04539FE3, 0x67D3492F, 0x0A20E7BF,
+	 0xAE6657C2, 0xB614EA24, 0x9A218F37, 0x9CCE0ECF,
+	 0x745FC317, 0xA549588D, 0x8F34FC73, 0xB3344364},
+	{0xAE118BEC, 0xCA0BB384, 0x2D6EC371, 0x7E5EFC7A,
+	 0x931F7A75, 0x35CA3D70, 0x11152993, 0x972B1CEC,
+	 0xFE636B50, 0x4803E014, 0xBC38F77D, 0xA1519BCB,
+	 0x7BEA81ED, 0xDB75A829, 0xDA4B0F60, 0x3F2043E5},
+	{0x2C206717, 0xC6B3F2AD, 0x75ABD071, 0xF1692C26,
+	 0x7394C19C, 0xBDD153DE, 0x89285704, 0x447BCD3B,
+	 0x34641E7F, 0x78DA031D, 0xA80BC2D0, 0x8E6AE13B,
+	 0x341942BB, 0x72648472, 0xD78B4F89, 0x57C7CE3E},
+	{0xD9FC1B22, 0xC0BA31A4, 0x13B372B4, 0x60A1AE4C,
+	 0xCC798845, 0x7434DD76, 0x038A735D, 0xA7E388BF,
+	 0x3405BC7D, 0x1124E44E, 0x3B79415D, 0x4386FE5F,
+	 0xF54544E3, 0xC43DC6FF, 0x310F5380, 0x73CA7B06},
+	{0xF40E5465, 0x90A24801, 0x5D1DB99E, 0x2F5A5536,
+	 0x3BD54E4B, 0x2576A471, 0xD2F78E00, 0xE87DCF14,
+	 0x66DAFB79, 0x31278D3D, 0x9091C8AC, 0xA942CF12,
+	 0x84B5B27B, 0x55C2D2B3, 0xAB579FE1, 0x52D5CEE6},
+	{0x6D6585D1, 0xA1A8FFD4, 0xABAFA172, 0xA149E128,
+	 0x78D9712A, 0x8F5B3ADE, 0x0C2862CB, 0x9C70167C,
+	 0xE2584AEC, 0x6D636942, 0xC5DD4E2C, 0xC7AA1F93,
+	 0x2D174B65, 0x5BFA8723, 0x522A96E4, 0x64CE6D36},
+	{0xD385A729, 0x6171553C, 0x5164C6CA, 0x7AF92DA5,
+	 0x144A5C5A, 0xFBD0E439, 0x291576C1, 0x9744F27A,
+	 0x5D955ED1, 0x607C6318, 0xCE236BE6, 0x5377113A,
+	 0x2CF909D9, 0x9B19348D, 0x4F5EC18E, 0x71520CDD},
+	{0xD1B3BB5D, 0x45261E75, 0x8DDBDF10, 0x1A0627FE,
+	 0x18A57E32, 0xC7197AC3, 0x2D326CCA, 0xFCE636D8,
+	 0x2EA40061, 0xC54AC12A, 0x12F318C7, 0xB1FAD885,
+	 0x4F7D05F9, 0xEA8BAFEE, 0x76CD5BA6, 0xF433B714},
+	{0x7D702E80, 0xEC5E5CC7, 0xA8EF02D3, 0x310EEFC5,
+	 0x64F07B5B, 0xFC8455AC, 0x8C40A254, 0x49E1D826,
+	 0xA0879D1E, 0x5C576AE2, 0xA25EC098, 0xEC4E52DA,
+	 0x9ADB6E80, 0xBBCED3DD, 0x23C408D3, 0xBD41DFA2},
+	{0x30F0681B, 0x4C8B876B, 0x1B763543, 0x1B635AE9,
+	 0xC125C12C, 0xB36C8605, 0xBCA1EA11, 0x90CD1070,
+	 0x32417470, 0xBBADCDB8, 0x67F527DB, 0x0CDD185A,
+	 0xA5B50054, 0x01F972BF, 0x5BEE1982, 0x6006E987},
+	{0x58B1FF29, 0x92C6C46E, 0x05B0500B, 0x5C30D989,
+	 0x3A9A0269, 0x268CB82B, 0x0743DD0A, 0xCB20F1D4,
+	 0xF18F9A55, 0xC244224A, 0xC72B298A, 0x036E32BF,
+	 0x56898E8E, 0x35B032E2, 0xBBAEE0B2, 0x6C3C17DF},
+	{0x12A99D2C, 0x5738FCAE, 0xF9A6EFA2, 0x4DCBF645,
+	 0xE452F126, 0xC63DD4EB, 0x1BD2F110, 0x462CB8CF,
+	 0xDF85CBF6, 0xCEFDB215, 0xF24CD959, 0x06237FC5,
+	 0x5720A5F7, 0xFE158F41, 0x7BA270A0, 0xC5C768FA},
+	{0x7F8C6A16, 0xBE3B93C7, 0x1E7EEB97, 0xA111691C,
+	 0xF831C143, 0xC20662A7, 0x4BAD54EB, 0xA8D5B128,
+	 0x26E900B3, 0xF9E1D4C2, 0x0231B6B4, 0x8F58482E,
+	 0x0B3C2FA3, 0xFF6F737B, 0x1AF5207E, 0x3592DEBA},
+	{0x48C60096, 0x929A3B15, 0x1ED1F604, 0x3A5E2845,
+	 0xF6889EA7, 0x7C6A713E, 0xE7B579FC, 0x44544057,
+	 0x4CDCA524, 0x87130F8C, 0xAAE8C04F, 0x41D1C96C,
+	 0xA6033D7E, 0x3C1F415D, 0x5AE7DBD3, 0xFCD2940B},
+	{0x35B3656A, 0xD93F0276, 0xE6BC9A10, 0x74630CC7,
+	 0xB932ADAB, 0xE82325C5, 0x420770AF, 0xD82F31D9,
+	 0xA5ECE08C, 0x30B4DF4B, 0x32F2AA4A, 0xA0B3B51E,
+	 0x17249A2A, 0x2B3A3408, 0xA1E6FD40, 0x038F163A},
+	{0x5A1949B7, 0x42218368, 0xFFA82C56, 0xBF74F78E,
+	 0x4545DBF6, 0x57D63FAE, 0x6B0CF9B6, 0xF1CF5892,
+	 0x26087C01, 0xC2A0AD34, 0x0C930F68, 0xF4E4D1FE,
+	 0xF763282C, 0x75E60572, 0xA3667F6F, 0x939E06BA},
+	{0x78D80ECB, 0x95CF1CA0, 0xD11127EB, 0x27EA1D59,
+	 0x99300FC2, 0x96C89C5A, 0x02B3D55A, 0xA99E00E0,
+	 0x84E7C072, 0x59E766FE, 0xBF72ABA1, 0xDB5F4F67,
+	 0xFB33097D, 0xD629057D, 0x24588385, 0xDFF379E7},
+	{0xA8A370EF, 0x45226040, 0x7A8B955A, 0xF7104CEC,
+	 0x97124479, 0x5AB4CF5F, 0x73CFD499, 0xCE0B469C,
+	 0xE433E07B, 0xB51056C8, 0xA1D6E672, 0xC4A6379C,
+	 0x45811DF9, 0x9921FCEA, 0xE2DB10E5, 0x23997E13},
+	{0x57B77133, 0x3C6887D4, 0x1324F743, 0x5FC726C3,
+	 0xB4416B49, 0x61E02B60, 0xF451D44F, 0xAD9ECCE8,
+	 0x4D9AF768, 0x7D8D52AF, 0x33626482, 0x121B624C,
+	 0x1F05A7A5, 0xBFBACE13, 0x081513F6, 0x4C8CDB1E},
+	{0x4B5E7018, 0x2C185C89, 0x036C4CDB, 0x41D56EF8,
+	 0xB9F6A6F7, 0xB278F0BD, 0xBF1E1D35, 0x81394FE4,
+	 0x313CA827, 0x39EB6488, 0x89B397F4, 0x8542546D,
+	 0x0C922CCB, 0xA50B02AB, 0x601067C0, 0x46C0E7CA},
+	{0xD5A60665, 0xB017C38A, 0x75E88EA6, 0xC9467B05,
+	 0x6F7875F8, 0xA1F30D0F, 0xD4D52601, 0x6C509286,
+	 0x1F2E45F0, 0xD1A5FB7C, 0x13401739, 0x5FF49A6B,
+	 0x87FA69E2, 0x4A4C26BB, 0x6B6ACC99, 0x214EACCB},
+	{0x925F1BCF, 0x99C02786, 0x5BE1197F, 0x4C4F91F3,
+	 0x65647440, 0x4D0A5377, 0x225A8B2C, 0xF4917BEE,
+	 0x759767C2, 0xFA755A6B, 0xD46F4804, 0x74FF7812,
+	 0xCDEEDFD4, 0x951140C7, 0x9380F1C5, 0x6D00E598},
+	{0x0BB76779, 0x1A20A370, 0x306978ED, 0x111CE0E1,
+	 0x4AC022C4, 0x75948097, 0x43655CB0, 0xB645F91B,
+	 0x12CD92B0, 0x5BCF539F, 0x3A757338, 0x2137A937,
+	 0xE36AE9A7, 0xEAD461A2, 0x12CF530E, 0xE1A101DA},
+	{0xCD528B04, 0xD5DEBC9A, 0x1B786569, 0x625F31B8,
+	 0x9FA42B4D, 0x2D317967, 0xAEBC9B0D, 0xC7DDC4AB,
+	 0xB53CBC38, 0x315918E7, 0xCCD2550E, 0xD5C518DD,
+	 0xE5AA733C, 0x2EF47CCB, 0xC28E171E, 0xF300D8DE},
+	{0xD5C95C8D, 0xD65C0764, 0x1721DA03, 0xE11F8821,
+	 0xB9760799, 0x4E9ECD19, 0x465E5431, 0x06B94AD8,
+	 0x1BEA72E0, 0xEE764DDF, 0xB211AEE1, 0x36462BD1,
+	 0x2F36FB4E, 0x436D7A52, 0x652E7F00, 0xF755F660},
+	{0x2E769094, 0x51AD6C57, 0x28B20FBC, 0x4C90638F,
+	 0x89B9B68D, 0xE55FBAF5, 0x7405F739, 0x31BB4FC1,
+	 0x686F057E, 0xAA157461, 0x4AE16ADF, 0x3B10A8B5,
+	 0x07605F1B, 0xC3E983B1, 0x8D413930, 0xE3B13E08},
+	{0xA2D942A8, 0x85837648, 0xA22ABE50, 0x84E0FA3F,
+	 0x3F897130, 0x5BB2A97B, 0xC763182C, 0x6BFB07C6,
+	 0xB1686C8F, 0x605895C6, 0x5279F0B4, 0x6014326C,
+	 0x7051C4A1, 0x76E75141, 0x13F25022, 0xE69C8A36},
+	{0x18053678, 0x98BBE4B0, 0xF426F786, 0xCB297C10,
+	 0x38EA1EF3, 0xB5841FA2, 0x4BB34022, 0xAC1B6CB4,
+	 0x4618E123, 0x6059F09F, 0xA66BF193, 0x62575192,
+	 0x9AF6D75D, 0xC529CF79, 0x1A4B66FB, 0xCAB819ED},
+	{0x1DA1B1D6, 0xCBD88B2E, 0xC27B1E7C, 0x7B87D24B,
+	 0x0C3B0B1D, 0x3D774398, 0xF86A7731, 0x6910D00A,
+	 0xDD8A50AC, 0xAB22C0BC, 0x86D5B8B2, 0xA7111611,
+	 0xCCFB442D, 0x998E16B2, 0x1F29A772, 0x45E46A3C},
+	{0x2D16BCB7, 0x7A58240D, 0x735406F1, 0x1E919FC3,
+	 0x66F42DA8, 0xA7F9F8FE, 0x9A32BDD9, 0x8BB9DF26,
+	 0x2EE5701E, 0x66CEB32E, 0x3E6D2A65, 0x0B1C63FC,
+	 0xA841114A, 0x919ABF7B, 0x45B20C63, 0x1FC16320},
+	{0x70ADC81C, 0xD1D20980, 0x960A6585, 0xC8B2DDA7,
+	 0x2E7B4DC2, 0xDD183C83, 0xA4664C88, 0xF656144F,
+	 0x4E99242B, 0x66DD8D86, 0x78E0DD46, 0x9C9DEE9D,
+	 0x66760073, 0x2CA79436, 0x20D638CE, 0xE97E38B8},
+	{0xC6FB151A, 0x77D30C0E, 0x971AB9B7, 0x449F5E48,
+	 0xE83D22E3, 0xCC748405, 0xB24CA275, 0x9162B379,
+	 0x4B19FD36, 0xD2273139, 0xBDA82A01, 0x070CC4B6,
+	 0xC9747B7E, 0x669FEB9A, 0xAB9F91C0, 0x723A6967},
+	{0xB33CF553, 0xAE2CF87D, 0xA6B4C27C, 0xC50CADDA,
+	 0xE95E0DEC, 0xC534B887, 0xBD82CEC7, 0xA2074157,
+	 0xE247B7FA, 0xF3C96D24, 0xFD7DCB2E, 0x87F4FB64,
+	 0x7D286EC2, 0x3FBA3A3E, 0x91A9195B, 0x2A278DF2},
+	{0x9B25D403, 0x6AC340A8, 0x0472F36E, 0xE42FCEF6,
+	 0xDCFAEA04, 0xA70637CD, 0x7912171A, 0xA307FE97,
+	 0x2FCD396F, 0xB9975A73, 0xA9019979, 0x875E1667,
+	 0x0E736A92, 0x7BE84994, 0x86C989FA, 0xD5AC8113},
+	{0xA9DE6E6F, 0xE94AE5CC, 0xE02C002B, 0xA809C530,
+	 0xD0BF0CF6, 0xF8613A85, 0x49B5056A, 0x07BBB3A0,
+	 0x1CC0C289, 0x2F384BDC, 0x51776494, 0xF07E08AD,
+	 0x979C0F51, 0x8544B598, 0x122D9076, 0x20404024},
+	{0xF303C9A3, 0xD32EF27D, 0xD7524E61, 0x7A11C23D,
+	 0x6C1E9848, 0x5E02CEC2, 0x60453FB4, 0xD032291F,
+	 0x8B6266D9, 0x1BE2DE55, 0x5D2BCF0E, 0x36FBE423,
+	 0xA79976D4, 0xF6820F29, 0xF6E30808, 0x9EDA119E},
+};
+#elif uECC_COMB_WIDTH != 0
+	#error uECC_COMB_WIDTH must be 0 or 2 to 7
+#endif
+
+#define WNAF_G_WIDTH 7
+static const uECC_word_t ecc_wnaf_table[32][NUM_ECC_WORDS * 2] = {
+	{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+	 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+	 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+	 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+	{0xC6E7FD6C, 0xFB41661B, 0xEFADA985, 0xE6C6B721,
+	 0x1D4BF165, 0xC8F7EF95, 0xA6330A44, 0x5ECBE4D1,
+	 0xA27D5032, 0x9A79B127, 0x384FB83D, 0xD82AB036,
+	 0x1A64A2EC, 0x374B06CE, 0x4998FF7E, 0x8734640C},
+	{0xC3D033ED, 0x21554A0D, 0x1F5BE524, 0xEF8C82FD,
+	 0x08668FDF, 0xD784C856, 0x515140D2, 0x51590B7A,
+	 0xFDA16DA4, 0xD1D0BB44, 0xD4D80888, 0x0D012F00,
+	 0xBF8A7926, 0x8AE1BF36, 0x904A727D, 0xE0C17DA8},
+	{0x3187B2A3, 0x30062870, 0xA80FEF5B, 0x7EF9F8B8,
+	 0x7C01FB60, 0x25BB3066, 0xA0BF7B46, 0x8E533B6F,
+	 0xC1F400B4, 0xC55E1A86, 0xCB041B21, 0x53C73633,
+	 0xA6F59000, 0x6D069F83, 0xE0331836, 0x73EB1DBD},
+	{0x90949EE0, 0xD79E8A4B, 0x2C6DF8B3, 0x9E0ACB8C,
+	 0x1D71F872, 0x878938D5, 0xFEDF0B71, 0xEA68D7B6,
+	 0x4DD048FA, 0xE85A224A, 0xA4DE823F, 0x4D714FEA,
+	 0x4A8EA0C8, 0x87014A96, 0x72C9FCE7, 0x2A2744C9},
+	{0x74BC21D1, 0x433391D3, 0x255048BF, 0x16742ED0,
+	 0xB0C21CDA, 0x0638379D, 0x883B4C59, 0x3ED113B7,
+	 0xE82A3740, 0xE2F8EEFC, 0x5E9889DA, 0x090D04DA,
+	 0xA4F4C68A, 0x24C843AF, 0xCCC4C8A2, 0x9099209A},
+	{0x46072C01, 0x98E15D9D, 0x65EAD58A, 0x792E284B,
+	 0xD85EE2FC, 0x61805DF2, 0xE0AC495A, 0x177C837A,
+	 0xEFC7BFD8, 0x9C43BBE2, 0xA1FB4DF3, 0x26EE14C3,
+	 0xB40F4E72, 0xA24091AD, 0x4EBEA558, 0x63BB58CD},
+	{0xE59B9D5F, 0x63668C63, 0xDE3A0EF1, 0xAE03AF92,
+	 0x99888265, 0xADFB3789, 0x971ABAE7, 0xF0454DC6,
+	 0x0D034F36, 0x47E59CDE, 0x75B5FA3F, 0x2A3B21CE,
+	 0x1F9643E6, 0x4E6594E5, 0x592E2D1F, 0xB5B93EE3},
+	{0x4738A73E, 0xBA1ABCE3, 0xF0D64AF8, 0x5FA68678,
+	 0x6F75301A, 0x9C0984B6, 0xC0F1CC3A, 0x47776904,
+	 0x71F1FCDC, 0x32F787FF, 0x28D5733F, 0x81B28044,
+	 0x77648E83, 0x62318565, 0xB5B95728, 0xAA005EE6},
+	{0xAB03ED83, 0xC1FC7B74, 0x57884895, 0x782C4522,
+	 0x7108C507, 0xCE39B7C1, 0x102C0C25, 0xCB6D2861,
+	 0x2BCECDAA, 0xE3915075, 0x30FA3E03, 0xA496716E,
+	 0x0D6D6CE4, 0x5C35E710, 0x24D9EF51, 0x58D7614B},
+	{0x67399E83, 0xFD76364E, 0xF42B1523, 0x3A582139,
+	 0xB473BCA5, 0x2E4AC86E, 0x86637C7B, 0x3250FCF6,
+	 0x71D48C09, 0x15DE24A0, 0x3B566A82, 0x897CD3C3,
+	 0x1D7EB88C, 0x97B3090D, 0x667D3593, 0x42E7C342},
+	{0x45CA7896, 0x672E5730, 0xDF64A4FE, 0x3C0BC0A5,
+	 0xD4583FA6, 0xD28A3E39, 0x9C2640D7, 0x0E91C723,
+	 0x3140AD55, 0x13804654, 0x75E7A5AE, 0x7E688335,
+	 0xB8E0BD6D, 0x1A22733B, 0x550DBA22, 0x5DF65C3B},
+	{0xF200D687, 0x84A4DC45, 0xB76F1B24, 0x41652FC5,
+	 0x8C07FA84, 0x85F4F52D, 0x4B0C0BB6, 0x3A67E255,
+	 0x02F79324, 0xA9ED16B3, 0x35A7618A, 0x8C188AF7,
+	 0x163AFB0D, 0x26DAF267, 0x2F1FCF43, 0x27D0F187},
+	{0x3B0883D1, 0xF2E20117, 0x683E54AB, 0x576355BD,
+	 0x4611F378, 0xDEBA2FAC, 0x19D80D51, 0x184FFA58,
+	 0x60906E6F, 0x20D242C2, 0x63F04916, 0x45BDECCC,
+	 0x26CB9995, 0xA4C6D908, 0x6688F359, 0xC0A66E27},
+	{0x1C784DEF, 0xDEDD693D, 0x88B58A41, 0xFD8CD1C6,
+	 0x90853B8C, 0xA7C36DA0, 0xFA195B07, 0xD6D33ADE,
+	 0x93D1BCA6, 0x550C1245, 0x4B95EDED, 0x09A166AB,
+	 0x558A5DCB, 0x3F78245F, 0xEE195D7E, 0x84AABA16},
+	{0xA1B45B8B, 0x3E3F9AA0, 0x52A95B3E, 0xFAC9DB7D,
+	 0xA7AE9AA0, 0xA85DA026, 0x2DC7E05D, 0x301D9E50,
+	 0xA17EE267, 0xD58DB6AE, 0x6887CA61, 0x298D9AE4,
+	 0x6B017D72, 0xE0D23C02, 0xB3061223, 0x6551B6F6},
+	{0xCB2CD793, 0x65C100F3, 0x3AA872FD, 0xA03B0A53,
+	 0x89D9D34E, 0xFA9AA25B, 0xFCD81356, 0x9807D699,
+	 0x79634AF4, 0x2F6BF924, 0x6C587853, 0xFFE630B9,
+	 0x1D091B2F, 0x86A01A4D, 0xCAB11BF2, 0xC2A59CDC},
+	{0x33BB291A, 0xA12D3890, 0x92AF9700, 0x94E8E1FE,
+	 0x326C48CA, 0x8FFA3AD7, 0x9ED27D16, 0xD58D4A58,
+	 0xF586B9D5, 0xA5B0C9C6, 0x3B034979, 0x67271C16,
+	 0x2DC7FEF6, 0x76EA9263, 0x02726B85, 0xD45514D1},
+	{0x502B3348, 0x73A92894, 0x246BFD44, 0xE0D21379,
+	 0x11A826AA, 0xD6B09786, 0x6DDB817D, 0x419A6A64,
+	 0xB09214B2, 0xDB1D6C81, 0xF3DEE1E2, 0x13C6D072,
+	 0x954C2FD5, 0x545C9FB1, 0x1102F584, 0x332544CF},
+	{0xFB2776C4, 0xA0C199DD, 0xD2D138D4, 0x547B942D,
+	 0xA179046E, 0x42014976, 0xC3996D4D, 0x22A682F7,
+	 0xCBAA285D, 0x5347F649, 0x0265B068, 0x979DCC31,
+	 0x5A54356C, 0xB918C983, 0x102223EE, 0x4F4606B0},
+	{0x995D2FA2, 0x3A7DE694, 0xD4175A59, 0x6067C5C3,
+	 0xE6CFE8AA, 0x1CF258D2, 0x40DEE065, 0x67A6BEC2,
+	 0x441FEED5, 0x49C24CE1, 0x209ACA6C, 0x1542C7EE,
+	 0x464D4499, 0x6C249B49, 0x22D13158, 0xDE692B70},
+	{0x9B82D28D, 0x7544DC12, 0xD009B30F, 0x8F4BC4C6,
+	 0x1D8F4B49, 0xD0423086, 0x6F1FF104, 0x986AE250,
+	 0x1BB07E97, 0x25110C44, 0x9C189F25, 0xD86FC628,
+	 0x7D3C7B61, 0xE328A4D9, 0xA6460E0A, 0x003CCCC0},
+	{0xFAE0BA03, 0x79C78080, 0xDD29D6D9, 0x0F5F609E,
+	 0xDFF0672E, 0x3ECD0F5D, 0x70BDE99B, 0xA891D066,
+	 0x166934AE, 0xEFC3EDC8, 0xFEB0F2CC, 0x1C6B38F0,
+	 0x033C1CE7, 0x419A88C4, 0x2CBFA1C1, 0xB596CD92},
+	{0x7B1C0D7C, 0x51D68922, 0x3E19066D, 0xDD5B3158,
+	 0x83071BBC, 0x595361EA, 0x48958708, 0x42C315CC,
+	 0xB2F9B1B9, 0xD6C4A72B, 0xEB87F164, 0x74F1A1E1,
+	 0xBB7A7990, 0x2914D1DF, 0x571B9585, 0x649A61CE},
+	{0xA5674455, 0x7D228CE6, 0x758FD4FD, 0x28FB7EA9,
+	 0x866E6C05, 0xBB22B146, 0x98068875, 0xF785B0E0,
+	 0x10D62408, 0xE7BC490C, 0x5F3AA60A, 0x4B04B6FD,
+	 0x0D9F5B41, 0xE15C767F, 0x6080DA6E, 0x73FDB0BF},
+	{0x018E22B1, 0x044360F0, 0xE81008FF, 0x95F7EB56,
+	 0x3C1D68BC, 0xAADEE686, 0x4D9DE43E, 0x672C4A51,
+	 0x91F37104, 0x99353991, 0x9704D941, 0x13624658,
+	 0xACE203F7, 0x611DE5A4, 0x96A25BFE, 0x548C7E91},
+	{0x7449D036, 0xF126EC9F, 0x8DE9B983, 0x982B1CA7,
+	 0x54B88039, 0x5A478022, 0xC9D95245, 0x6F01BD49,
+	 0x989E17DB, 0x360233DD, 0xC3749B08, 0xA78551BF,
+	 0x608776CE, 0x11A0F21A, 0xF1D5DEAB, 0x1562080F},
+	{0xDF6E60A0, 0xDEC1DFF7, 0x62C1EADA, 0xC2A595B7,
+	 0xFE7FEA2C, 0x7571A109, 0xA068C926, 0x079DBA7B,
+	 0xB4824DEA, 0xFB0DA5AE, 0x5751A397, 0x83EB2DF3,
+	 0x2A9588AB, 0x1D223F9D, 0x43D4D181, 0xDC1E19B7},
+	{0xD0F56077, 0x8ABD97B1, 0x2D6C6BD8, 0x289D406E,
+	 0xEA907F86, 0x126D45A8, 0xBB4D2865, 0xC116E30E,
+	 0xA410C206, 0x313FD7FD, 0x9E59C8C5, 0x7D5BD5E8,
+	 0xB13B8765, 0xB8B16D9B, 0xC35B30C2, 0xE9478823},
+	{0x0FAA4B45, 0xA2B6EA0E, 0x9E8DC8EC, 0xE5094111,
+	 0xFCA9BDF7, 0x765B2784, 0xFE0C6437, 0x665F1A6F,
+	 0x2B7F4CCF, 0x6E25A660, 0x81E215BC, 0x7DEDE5BF,
+	 0xF7EAC37F, 0x6E8CCA29, 0x9FFD18C2, 0x490E2CA4},
+	{0x0D32AF0E, 0x5939AC38, 0x8B724FD5, 0x3E7910A0,
+	 0x8D990001, 0x2D3A6B3D, 0xEDD3DA9A, 0x059CCB19,
+	 0x97FE91D1, 0x928E1E3C, 0x3956CECD, 0x1621F7A3,
+	 0x9345638E, 0xDA65281B, 0xCAD49159, 0xBB6AD7EC},
+	{0x5D8BDAC1, 0x32A29082, 0x01A7CD38, 0xDF53C8AF,
+	 0x8ACC7D8F, 0x2A1F28A0, 0x5BF5DC80, 0x6A9501D8,
+	 0x5F1EF1A3, 0x30AFF53D, 0x697A6F35, 0xF8461B5C,
+	 0x4A3C56A3, 0x81C6C6E4, 0x93473743, 0xCA640AD1},
+};
+
+#endif /* __TC_ECC_COMB_TABLE_H__ */
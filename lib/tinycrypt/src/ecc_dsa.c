@@ -56,6 +56,7 @@
 #include <tinycrypt/constants.h>
 #include <tinycrypt/ecc.h>
 #include <tinycrypt/ecc_dsa.h>
+#include <tinycrypt/utils.h>
 
 static void bits2int(
 	uECC_word_t *native, const uint8_t *bits, unsigned bits_size,
@@ -86,17 +87,13 @@ static void bits2int(
 	}
 }
 
-int uECC_sign_with_k(
-	const uint8_t *private_key, const uint8_t *message_hash, unsigned hash_size,
-	uECC_word_t *k, uint8_t *signature, uECC_Curve curve) {
+/* Computes r = (k.G).x and the blinded inverse of k. Clobbers k. */
+static int precompute_k(
+	uECC_word_t *k, uECC_sign_nonce_t *nonce, uECC_Curve curve) {
 	uECC_word_t tmp[NUM_ECC_WORDS];
-	uECC_word_t s[NUM_ECC_WORDS];
-	uECC_word_t *k2[2] = {tmp, s};
 	uECC_word_t p[NUM_ECC_WORDS * 2];
-	uECC_word_t carry;
 	wordcount_t num_words	= curve->num_words;
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
-	bitcount_t num_n_bits	= curve->num_n_bits;
 
 	/* Make sure 0 < k < curve_n */
 	if (uECC_vli_isZero(k, num_words) ||
@@ -104,8 +101,7 @@ int uECC_sign_with_k(
 		return 0;
 	}
 
-	carry = regularize_k(k, tmp, s, curve);
-	EccPoint_mult(p, curve->G, k2[!carry], 0, num_n_bits + 1, curve);
+	EccPoint_mult_base(p, k, curve);
 	if (uECC_vli_isZero(p, num_words)) { return 0; }
 
 	/* If an RNG function was specified, get a random number
@@ -122,25 +118,61 @@ int uECC_sign_with_k(
 	uECC_vli_modMult(k, k, tmp, curve->n, num_n_words); /* k' = rand * k */
 	uECC_vli_modInv(k, k, curve->n, num_n_words);		/* k = 1 / k' */
 	uECC_vli_modMult(k, k, tmp, curve->n, num_n_words); /* k = 1 / k */
+	_set_secure(tmp, 0, sizeof(tmp));
 
-	uECC_vli_nativeToBytes(signature, curve->num_bytes, p); /* store r */
+	uECC_vli_set(nonce->k_inv, k, num_words);
+	uECC_vli_set(nonce->r, p, num_words);
+	return 1;
+}
+
+int uECC_sign_with_nonce(
+	const uint8_t *private_key, const uint8_t *message_hash, unsigned hash_size,
+	uECC_sign_nonce_t *nonce, uint8_t *signature, uECC_Curve curve) {
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	uECC_word_t s[NUM_ECC_WORDS];
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	int result				= 0;
+
+	if (uECC_vli_isZero(nonce->k_inv, num_words)) { goto clear; }
+
+	uECC_vli_nativeToBytes(signature, curve->num_bytes, nonce->r); /* store r */
 
 	/* tmp = d: */
 	uECC_vli_bytesToNative(tmp, private_key, BITS_TO_BYTES(curve->num_n_bits));
 
 	s[num_n_words - 1] = 0;
-	uECC_vli_set(s, p, num_words);
+	uECC_vli_set(s, nonce->r, num_words);
 	uECC_vli_modMult(s, tmp, s, curve->n, num_n_words); /* s = r*d */
 
 	bits2int(tmp, message_hash, hash_size, curve);
 	uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words); /* s = e + r*d */
-	uECC_vli_modMult(s, s, k, curve->n, num_n_words);  /* s = (e + r*d) / k */
+	uECC_vli_modMult(
+		s, s, nonce->k_inv, curve->n, num_n_words); /* s = (e + r*d) / k */
 	if (uECC_vli_numBits(s, num_n_words) > (bitcount_t)curve->num_bytes * 8) {
-		return 0;
+		goto clear;
 	}
 
 	uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
-	return 1;
+	result = 1;
+
+clear:
+	_set_secure(tmp, 0, sizeof(tmp));
+	_set_secure(nonce, 0, sizeof(*nonce));
+	return result;
+}
+
+int uECC_sign_with_k(
+	const uint8_t *private_key, const uint8_t *message_hash, unsigned hash_size,
+	uECC_word_t *k, uint8_t *signature, uECC_Curve curve) {
+	uECC_sign_nonce_t nonce;
+
+	if (!precompute_k(k, &nonce, curve)) {
+		_set_secure(&nonce, 0, sizeof(nonce));
+		return 0;
+	}
+	return uECC_sign_with_nonce(
+		private_key, message_hash, hash_size, &nonce, signature, curve);
 }
 
 int uECC_sign(
@@ -170,36 +202,44 @@ int uECC_sign(
 	return 0;
 }
 
-static bitcount_t smax(bitcount_t a, bitcount_t b) { return (a > b ? a : b); }
+int uECC_sign_precompute(uECC_sign_nonce_t *nonce, uECC_Curve curve) {
+	uECC_word_t _random[2 * NUM_ECC_WORDS];
+	uECC_word_t k[NUM_ECC_WORDS];
+	uECC_word_t tries;
+	int result = 0;
 
-int uECC_verify(
-	const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
-	const uint8_t *signature, uECC_Curve curve) {
-	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
-	uECC_word_t z[NUM_ECC_WORDS];
-	uECC_word_t sum[NUM_ECC_WORDS * 2];
-	uECC_word_t rx[NUM_ECC_WORDS];
-	uECC_word_t ry[NUM_ECC_WORDS];
-	uECC_word_t tx[NUM_ECC_WORDS];
-	uECC_word_t ty[NUM_ECC_WORDS];
-	uECC_word_t tz[NUM_ECC_WORDS];
-	const uECC_word_t *points[4];
-	const uECC_word_t *point;
-	bitcount_t num_bits;
-	bitcount_t i;
+	for (tries = 0; tries < uECC_RNG_MAX_TRIES && !result; ++tries) {
+		uECC_RNG_Function rng_function = uECC_get_rng();
+		if (!rng_function ||
+			!rng_function(
+				(uint8_t *)_random, 2 * NUM_ECC_WORDS * uECC_WORD_SIZE)) {
+			break;
+		}
 
-	uECC_word_t _public[NUM_ECC_WORDS * 2];
-	uECC_word_t r[NUM_ECC_WORDS], s[NUM_ECC_WORDS];
+		uECC_vli_mmod(k, _random, curve->n, BITS_TO_WORDS(curve->num_n_bits));
+		result = precompute_k(k, nonce, curve);
+	}
+
+	_set_secure(_random, 0, sizeof(_random));
+	_set_secure(k, 0, sizeof(k));
+	if (!result) { _set_secure(nonce, 0, sizeof(*nonce)); }
+	return result;
+}
+
+/* Parses r and s from a signature and computes u1 = e/s and u2 = r/s.
+ * Returns 0 if r or s is out of range. */
+static int verify_scalars(
+	uECC_word_t *u1, uECC_word_t *u2, uECC_word_t *r,
+	const uint8_t *message_hash, unsigned hash_size, const uint8_t *signature,
+	uECC_Curve curve) {
+	uECC_word_t s[NUM_ECC_WORDS];
+	uECC_word_t z[NUM_ECC_WORDS];
 	wordcount_t num_words	= curve->num_words;
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 
-	rx[num_n_words - 1] = 0;
-	r[num_n_words - 1]	= 0;
-	s[num_n_words - 1]	= 0;
+	r[num_n_words - 1] = 0;
+	s[num_n_words - 1] = 0;
 
-	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
-	uECC_vli_bytesToNative(
-		_public + num_words, public_key + curve->num_bytes, curve->num_bytes);
 	uECC_vli_bytesToNative(r, signature, curve->num_bytes);
 	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
 
@@ -220,52 +260,12 @@ int uECC_verify(
 	bits2int(u1, message_hash, hash_size, curve);
 	uECC_vli_modMult(u1, u1, z, curve->n, num_n_words); /* u1 = e/s */
 	uECC_vli_modMult(u2, r, z, curve->n, num_n_words);	/* u2 = r/s */
+	return 1;
+}
 
-	/* Calculate sum = G + Q. */
-	uECC_vli_set(sum, _public, num_words);
-	uECC_vli_set(sum + num_words, _public + num_words, num_words);
-	uECC_vli_set(tx, curve->G, num_words);
-	uECC_vli_set(ty, curve->G + num_words, num_words);
-	uECC_vli_modSub(z, sum, tx, curve->p, num_words); /* z = x2 - x1 */
-	XYcZ_add(tx, ty, sum, sum + num_words, curve);
-	uECC_vli_modInv(z, z, curve->p, num_words); /* z = 1/z */
-	apply_z(sum, sum + num_words, z, curve);
-
-	/* Use Shamir's trick to calculate u1*G + u2*Q */
-	points[0] = 0;
-	points[1] = curve->G;
-	points[2] = _public;
-	points[3] = sum;
-	num_bits  = smax(
-		 uECC_vli_numBits(u1, num_n_words), uECC_vli_numBits(u2, num_n_words));
-
-	point = points
-		[(!!uECC_vli_testBit(u1, num_bits - 1)) |
-		 ((!!uECC_vli_testBit(u2, num_bits - 1)) << 1)];
-	uECC_vli_set(rx, point, num_words);
-	uECC_vli_set(ry, point + num_words, num_words);
-	uECC_vli_clear(z, num_words);
-	z[0] = 1;
-
-	for (i = num_bits - 2; i >= 0; --i) {
-		uECC_word_t index;
-		curve->double_jacobian(rx, ry, z, curve);
-
-		index =
-			(!!uECC_vli_testBit(u1, i)) | ((!!uECC_vli_testBit(u2, i)) << 1);
-		point = points[index];
-		if (point) {
-			uECC_vli_set(tx, point, num_words);
-			uECC_vli_set(ty, point + num_words, num_words);
-			apply_z(tx, ty, z, curve);
-			uECC_vli_modSub(tz, rx, tx, curve->p, num_words); /* Z = x2 - x1 */
-			XYcZ_add(tx, ty, rx, ry, curve);
-			uECC_vli_modMult_fast(z, z, tz, curve);
-		}
-	}
-
-	uECC_vli_modInv(z, z, curve->p, num_words); /* Z = 1/Z */
-	apply_z(rx, ry, z, curve);
+/* Accepts if the x coordinate of u1*G + u2*Q, reduced mod n, equals r */
+static int verify_x(uECC_word_t *rx, const uECC_word_t *r, uECC_Curve curve) {
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 
 	/* v = x1 (mod n) */
 	if (uECC_vli_cmp_unsafe(curve->n, rx, num_n_words) != 1) {
@@ -273,5 +273,60 @@ int uECC_verify(
 	}
 
 	/* Accept only if v == r. */
-	return (int)(uECC_vli_equal(rx, r, num_words) == 0);
+	return (int)(uECC_vli_equal(rx, r, curve->num_words) == 0);
+}
+
+int uECC_verify(
+	const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+	const uint8_t *signature, uECC_Curve curve) {
+	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+	uECC_word_t r[NUM_ECC_WORDS];
+	uECC_word_t sum[NUM_ECC_WORDS * 2];
+	uECC_word_t _public[NUM_ECC_WORDS * 2];
+	wordcount_t num_words = curve->num_words;
+
+	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
+	uECC_vli_bytesToNative(
+		_public + num_words, public_key + curve->num_bytes, curve->num_bytes);
+
+	if (!verify_scalars(
+			u1, u2, r, message_hash, hash_size, signature, curve)) {
+		return 0;
+	}
+
+	EccPoint_mult_twin_wnaf(sum, u1, u2, _public, curve);
+	if (EccPoint_isZero(sum, curve)) { return 0; }
+
+	return verify_x(sum, r, curve);
+}
+
+int uECC_verify_table(
+	const uECC_word_t *table, unsigned int width, const uint8_t *message_hash,
+	unsigned hash_size, const uint8_t *signature, uECC_Curve curve) {
+#if uECC_COMB_WIDTH != 0
+	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+	uECC_word_t r[NUM_ECC_WORDS];
+	uECC_word_t sum[NUM_ECC_WORDS * 2];
+
+	if (width < 2 || width > 7) { return 0; }
+	if (!verify_scalars(
+			u1, u2, r, message_hash, hash_size, signature, curve)) {
+		return 0;
+	}
+
+	EccPoint_mult_twin_vartime(sum, u1, u2, table, width, curve);
+	if (EccPoint_isZero(sum, curve)) { return 0; }
+
+	return verify_x(sum, r, curve);
+#else
+	/* Without the generator comb, verify against the key in entry 0 */
+	uint8_t public_key[NUM_ECC_BYTES * 2];
+
+	if (width < 2 || width > 7) { return 0; }
+	uECC_vli_nativeToBytes(public_key, curve->num_bytes, table);
+	uECC_vli_nativeToBytes(
+		public_key + curve->num_bytes, curve->num_bytes,
+		table + curve->num_words);
+	return uECC_verify(public_key, message_hash, hash_size, signature, curve);
+#endif
 }
@@ -127,3 +127,59 @@ int tc_hmac_final(uint8_t *tag, unsigned int taglen, TCHmacState_t ctx) {
 
 	return TC_CRYPTO_SUCCESS;
 }
+
+int tc_hmac_set_midstate(
+	TCHmacMidstate_t mid, const uint8_t *key, unsigned int key_size) {
+	struct tc_hmac_state_struct ctx;
+
+	/* Input sanity check */
+	if (mid == (TCHmacMidstate_t)0 ||
+		tc_hmac_set_key(&ctx, key, key_size) != TC_CRYPTO_SUCCESS) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	(void)tc_sha256_init(&mid->inner);
+	(void)tc_sha256_update(&mid->inner, ctx.key, TC_SHA256_BLOCK_SIZE);
+	(void)tc_sha256_init(&mid->outer);
+	(void)tc_sha256_update(
+		&mid->outer, &ctx.key[TC_SHA256_BLOCK_SIZE], TC_SHA256_BLOCK_SIZE);
+
+	/* destroy the padded key */
+	_set(&ctx, 0, sizeof(ctx));
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_hmac_init_midstate(
+	TCHmacState_t ctx, const struct tc_hmac_midstate_struct *mid) {
+	/* input sanity check: */
+	if (ctx == (TCHmacState_t)0 ||
+		mid == (const struct tc_hmac_midstate_struct *)0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	ctx->hash_state = mid->inner;
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_hmac_final_midstate(uint8_t *tag, unsigned int taglen,
+	TCHmacState_t ctx, const struct tc_hmac_midstate_struct *mid) {
+	/* input sanity check: */
+	if (tag == (uint8_t *)0 || taglen != TC_SHA256_DIGEST_SIZE ||
+		ctx == (TCHmacState_t)0 ||
+		mid == (const struct tc_hmac_midstate_struct *)0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	(void)tc_sha256_final(tag, &ctx->hash_state);
+
+	ctx->hash_state = mid->outer;
+	(void)tc_sha256_update(&ctx->hash_state, tag, TC_SHA256_DIGEST_SIZE);
+	(void)tc_sha256_final(tag, &ctx->hash_state);
+
+	/* destroy the current state */
+	_set(ctx, 0, sizeof(*ctx));
+
+	return TC_CRYPTO_SUCCESS;
+}
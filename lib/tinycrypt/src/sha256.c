@@ -35,6 +35,13 @@
 #include <tinycrypt/utils.h>
 
 static void compress(unsigned int *iv, const uint8_t *data);
+static void expand(unsigned int *w, const uint8_t *data);
+static void compress_expanded(unsigned int *iv, const unsigned int *w);
+
+/* Most distinct blocks tc_sha256_update_repeated keeps schedules for. Each
+schedule is 256 bytes on the stack, 1 KB in all, unlike compress which only
+keeps a rolling 16 word window */
+#define TC_SHA256_REPEAT_MAX_BLOCKS (4)
 
 int tc_sha256_init(TCSha256State_t s) {
 	/* input sanity check: */
@@ -79,6 +86,70 @@ int tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen) {
 	return TC_CRYPTO_SUCCESS;
 }
 
+int tc_sha256_update_repeated(
+	TCSha256State_t s, const uint8_t *data, size_t datalen, unsigned int count) {
+	unsigned int w[TC_SHA256_REPEAT_MAX_BLOCKS][64];
+	uint8_t block[TC_SHA256_BLOCK_SIZE];
+	size_t remaining;
+	size_t blocks;
+	size_t period;
+	size_t pos;
+	size_t b;
+	size_t i;
+
+	/* input sanity check: */
+	if (s == (TCSha256State_t)0 || data == (void *)0) {
+		return TC_CRYPTO_FAIL;
+	} else if (datalen == 0 || count == 0) {
+		return TC_CRYPTO_SUCCESS;
+	}
+
+	/* the stream repeats every lcm(datalen, 64) bytes, that is every
+	datalen / gcd(datalen, 64) blocks */
+	for (i = 1; i < TC_SHA256_BLOCK_SIZE && datalen % (i << 1) == 0; i <<= 1) {}
+	period = datalen / i;
+	if (period > TC_SHA256_REPEAT_MAX_BLOCKS ||
+		count > ((size_t)-1) / datalen) {
+		while (count-- > 0) { (void)tc_sha256_update(s, data, datalen); }
+		return TC_CRYPTO_SUCCESS;
+	}
+
+	remaining = datalen * count;
+	pos		  = 0;
+
+	/* top up a partial block the generic way */
+	while (remaining > 0 && s->leftover_offset != 0) {
+		(void)tc_sha256_update(s, data + pos, 1);
+		pos = (pos + 1) % datalen;
+		--remaining;
+	}
+
+	/* expand each distinct block once, then only run the rounds */
+	blocks = remaining / TC_SHA256_BLOCK_SIZE;
+	for (b = 0; b < period && b < blocks; ++b) {
+		for (i = 0; i < TC_SHA256_BLOCK_SIZE; ++i) {
+			block[i] = data[(pos + b * TC_SHA256_BLOCK_SIZE + i) % datalen];
+		}
+		expand(w[b], block);
+	}
+	for (b = 0; b < blocks; ++b) {
+		compress_expanded(s->iv, w[b % period]);
+		s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
+	}
+	pos = (pos + blocks * TC_SHA256_BLOCK_SIZE) % datalen;
+	remaining -= blocks * TC_SHA256_BLOCK_SIZE;
+
+	/* leave the rest in the partial block */
+	while (remaining-- > 0) {
+		(void)tc_sha256_update(s, data + pos, 1);
+		pos = (pos + 1) % datalen;
+	}
+
+	_set(w, 0x00, sizeof(w));
+	_set(block, 0x00, sizeof(block));
+	return TC_CRYPTO_SUCCESS;
+}
+
 int tc_sha256_final(uint8_t *digest, TCSha256State_t s) {
 	unsigned int i;
 
@@ -160,6 +231,21 @@ static inline unsigned int ROTR(unsigned int a, unsigned int n) {
 #define Ch(a, b, c)	 (((a) & (b)) ^ ((~(a)) & (c)))
 #define Maj(a, b, c) (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)))
 
+/* one round on the caller's working variables a..h, kw is k256[i] + w[i] */
+#define ROUND(kw)                                \
+	do {                                         \
+		t1 = h + Sigma1(e) + Ch(e, f, g) + (kw); \
+		t2 = Sigma0(a) + Maj(a, b, c);           \
+		h  = g;                                  \
+		g  = f;                                  \
+		f  = e;                                  \
+		e  = d + t1;                             \
+		d  = c;                                  \
+		c  = b;                                  \
+		b  = a;                                  \
+		a  = t1 + t2;                            \
+	} while (0)
+
 static inline unsigned int BigEndian(const uint8_t **c) {
 	unsigned int n = 0;
 
@@ -188,18 +274,8 @@ static void compress(unsigned int *iv, const uint8_t *data) {
 	h = iv[7];
 
 	for (i = 0; i < 16; ++i) {
-		n  = BigEndian(&data);
-		t1 = work_space[i] = n;
-		t1 += h + Sigma1(e) + Ch(e, f, g) + k256[i];
-		t2 = Sigma0(a) + Maj(a, b, c);
-		h  = g;
-		g  = f;
-		f  = e;
-		e  = d + t1;
-		d  = c;
-		c  = b;
-		b  = a;
-		a  = t1 + t2;
+		n = work_space[i] = BigEndian(&data);
+		ROUND(k256[i] + n);
 	}
 
 	for (; i < 64; ++i) {
@@ -208,18 +284,44 @@ static void compress(unsigned int *iv, const uint8_t *data) {
 		s1 = work_space[(i + 14) & 0x0f];
 		s1 = sigma1(s1);
 
-		t1 = work_space[i & 0xf] += s0 + s1 + work_space[(i + 9) & 0xf];
-		t1 += h + Sigma1(e) + Ch(e, f, g) + k256[i];
-		t2 = Sigma0(a) + Maj(a, b, c);
-		h  = g;
-		g  = f;
-		f  = e;
-		e  = d + t1;
-		d  = c;
-		c  = b;
-		b  = a;
-		a  = t1 + t2;
+		n = work_space[i & 0xf] += s0 + s1 + work_space[(i + 9) & 0xf];
+		ROUND(k256[i] + n);
+	}
+
+	iv[0] += a;
+	iv[1] += b;
+	iv[2] += c;
+	iv[3] += d;
+	iv[4] += e;
+	iv[5] += f;
+	iv[6] += g;
+	iv[7] += h;
+}
+
+static void expand(unsigned int *w, const uint8_t *data) {
+	unsigned int i;
+
+	for (i = 0; i < 16; ++i) { w[i] = BigEndian(&data); }
+	for (; i < 64; ++i) {
+		w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
 	}
+}
+
+static void compress_expanded(unsigned int *iv, const unsigned int *w) {
+	unsigned int a, b, c, d, e, f, g, h;
+	unsigned int t1, t2;
+	unsigned int i;
+
+	a = iv[0];
+	b = iv[1];
+	c = iv[2];
+	d = iv[3];
+	e = iv[4];
+	f = iv[5];
+	g = iv[6];
+	h = iv[7];
+
+	for (i = 0; i < 64; ++i) { ROUND(k256[i] + w[i]); }
 
 	iv[0] += a;
 	iv[1] += b;
@@ -0,0 +1,141 @@
+"""End-to-end latency benchmark of the simulated AP and components
+
+Starts the simulated AP with its components attached to the timed I2C bus,
+drives it over stdin/stdout like the host tools do, and reports the latency of
+the list, attest, replace and boot commands. Boot never returns to the command
+prompt, so it runs last and every run starts from a fresh set of processes.
+"""
+
+import argparse
+import re
+import statistics
+import subprocess
+import time
+
+MESSAGE = re.compile(r"%(ack|success|error|info|debug)(?:: (.*?))?%", re.DOTALL)
+
+
+class Device:
+    """Simulated AP process speaking the host protocol"""
+
+    def __init__(self, ap: str, components: list[str]) -> None:
+        """Start the AP, which spawns the components
+
+        Args:
+            ap (str): AP executable
+            components (list[str]): Component executables
+        """
+        self.proc = subprocess.Popen(
+            [ap, *components],
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+            bufsize=0,
+        )
+        self.buf = ""
+
+    def next_message(self) -> tuple[str, str]:
+        """Read the next %type: body% message
+
+        Returns:
+            tuple[str, str]: Message type and body
+        """
+        while True:
+            match = MESSAGE.search(self.buf)
+            if match:
+                self.buf = self.buf[match.end() :]
+                return match.group(1), match.group(2) or ""
+            data = self.proc.stdout.read(4096)
+            if not data:
+                raise RuntimeError("AP exited")
+            self.buf += data.decode(errors="replace")
+
+    def command(self, cmd: str, inputs: list[str]) -> tuple[bool, float]:
+        """Run a command, answering its prompts in order
+
+        Args:
+            cmd (str): Command name
+            inputs (list[str]): Answers to the prompts after the command
+
+        Returns:
+            tuple[bool, float]: Whether it succeeded and its latency in ms
+        """
+        while self.next_message()[0] != "ack":
+            pass
+
+        pending = list(inputs)
+        start = time.perf_counter()
+        self.proc.stdin.write(f"{cmd}\n".encode())
+        while True:
+            kind, _ = self.next_message()
+            if kind == "ack" and pending:
+                self.proc.stdin.write(f"{pending.pop(0)}\n".encode())
+            elif kind in ("success", "error"):
+                elapsed = (time.perf_counter() - start) * 1000
+                return kind == "success", elapsed
+
+    def close(self) -> None:
+        """Stop the AP, the components exit with it"""
+        self.proc.kill()
+        self.proc.wait()
+
+
+def run_once(args: argparse.Namespace) -> dict[str, tuple[bool, float]]:
+    """Run every command once against fresh processes
+
+    Args:
+        args (argparse.Namespace): Parsed command line
+
+    Returns:
+        dict[str, tuple[bool, float]]: Result and latency of each command
+    """
+    component_id = args.component_id
+    device = Device(args.ap, args.components)
+    try:
+        return {
+            "list": device.command("list", []),
+            "attest": device.command("attest", [args.pin, component_id]),
+            "replace": device.command(
+                "replace", [args.token, component_id, component_id]
+            ),
+            "boot": device.command("boot", []),
+        }
+    finally:
+        device.close()
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--ap", required=True, help="simulated AP executable")
+    parser.add_argument("--pin", required=True, help="attestation PIN")
+    parser.add_argument("--token", required=True, help="replacement token")
+    parser.add_argument("--runs", type=int, default=5, help="number of runs")
+    parser.add_argument(
+        "--component-id", help="component to attest (default: from first path)"
+    )
+    parser.add_argument("components", nargs="+", help="component executables")
+    args = parser.parse_args()
+
+    if args.component_id is None:
+        found = re.search(r"comp_(0x[0-9a-fA-F]+)", args.components[0])
+        if not found:
+            parser.error("--component-id is required")
+        args.component_id = found.group(1)
+
+    results: dict[str, list[float]] = {}
+    failures: dict[str, int] = {}
+    for _ in range(args.runs):
+        for cmd, (ok, ms) in run_once(args).items():
+            results.setdefault(cmd, []).append(ms)
+            failures[cmd] = failures.get(cmd, 0) + (0 if ok else 1)
+
+    print(f"{len(args.components)} components, {args.runs} runs")
+    print(f"{'command':<10}{'min ms':>10}{'median ms':>12}{'max ms':>10}  failed")
+    for cmd, times in results.items():
+        print(
+            f"{cmd:<10}{min(times):>10.2f}{statistics.median(times):>12.2f}"
+            f"{max(times):>10.2f}  {failures[cmd]}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,59 @@
+/**
+ * @file aes.h
+ * @brief Simulated MSDK AES engine (software AES-128 ECB)
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_AES
+#define SIM_AES
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MXC_AES_128BITS,
+    MXC_AES_192BITS,
+    MXC_AES_256BITS
+} mxc_aes_keys_t;
+
+typedef enum {
+    MXC_AES_ENCRYPT_EXT_KEY = 0,
+    MXC_AES_DECRYPT_EXT_KEY = 1,
+    MXC_AES_DECRYPT_INT_KEY = 2
+} mxc_aes_enc_type_t;
+
+typedef struct {
+    uint32_t length;
+    uint32_t *inputData;
+    uint32_t *resultData;
+    mxc_aes_keys_t keySize;
+    mxc_aes_enc_type_t encryption;
+} mxc_aes_req_t;
+
+int MXC_AES_Init(void);
+int MXC_AES_Shutdown(void);
+void MXC_AES_SetExtKey(const void *key, mxc_aes_keys_t len);
+
+/**
+ * @brief Encrypt length words in ECB mode with the external key
+ *
+ * @param req Request, only 128 bit keys are simulated
+ * @return int E_NO_ERROR or E_NOT_SUPPORTED
+ */
+int MXC_AES_Encrypt(mxc_aes_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_AES */
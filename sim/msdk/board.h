@@ -0,0 +1,17 @@
+/**
+ * @file board.h
+ * @brief Simulated board support package
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_BOARD
+#define SIM_BOARD
+
+#include "led.h"
+
+#define CONSOLE_UART 0
+
+#endif /* SIM_BOARD */
@@ -0,0 +1,73 @@
+/**
+ * @file core_cm4.h
+ * @brief Simulated Cortex-M4 debug and trace registers and sleep instructions
+ * @version 0.1
+ *
+ * Only the DWT cycle counter is modelled. From C++ reading CYCCNT returns the
+ * host's monotonic clock scaled to SystemCoreClock, so cycle counts measure
+ * host time at the MCU's clock rate. WFE and WFI block the calling thread
+ * until SEV is executed or an interrupt is taken, DMB is a host fence
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_CORE_CM4
+#define SIM_CORE_CM4
+
+#include <stdint.h>
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#ifdef __cplusplus
+/**
+ * @brief Free-running cycle counter backed by the host clock
+ *
+ */
+struct sim_cyccnt_t {
+    operator uint32_t() const;
+    sim_cyccnt_t &operator=(uint32_t value);
+};
+
+typedef struct {
+    volatile uint32_t CTRL;
+    sim_cyccnt_t CYCCNT;
+} DWT_Type;
+#else
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+#endif
+
+extern DWT_Type sim_dwt_regs;
+extern CoreDebug_Type sim_core_debug_regs;
+
+#define DWT (&sim_dwt_regs)
+#define CoreDebug (&sim_core_debug_regs)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void __WFE(void);
+void __WFI(void);
+void __SEV(void);
+
+/**
+ * @brief Data memory barrier, a full fence between the simulated ISR and main
+ * threads
+ *
+ */
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CORE_CM4 */
@@ -0,0 +1,45 @@
+/**
+ * @file crc.h
+ * @brief Simulated MSDK CRC engine
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_CRC
+#define SIM_CRC
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t *dataBuffer;
+    uint32_t dataLen;
+    uint32_t resultCRC;
+} mxc_crc_req_t;
+
+int MXC_CRC_Init(void);
+int MXC_CRC_Shutdown(void);
+void MXC_CRC_SetPoly(uint32_t poly);
+
+/**
+ * @brief Reflected CRC32 of dataLen words with the configured polynomial
+ *
+ * @param req Request, resultCRC is overwritten
+ * @return int E_NO_ERROR
+ */
+int MXC_CRC_Compute(mxc_crc_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CRC */
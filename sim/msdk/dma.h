@@ -0,0 +1,82 @@
+/**
+ * @file dma.h
+ * @brief Simulated MSDK DMA controller
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_DMA
+#define SIM_DMA
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MXC_DMA_CH_GET_IRQ(i) ((IRQn_Type)(DMA0_IRQn + (i)))
+
+// Request lines of the peripherals the simulation moves data for
+typedef enum {
+    MXC_DMA_REQUEST_MEMTOMEM = 0x00,
+    MXC_DMA_REQUEST_I2C0RX = 0x07,
+    MXC_DMA_REQUEST_I2C1RX = 0x08,
+    MXC_DMA_REQUEST_I2C2RX = 0x0C,
+    MXC_DMA_REQUEST_I2C0TX = 0x27,
+    MXC_DMA_REQUEST_I2C1TX = 0x28,
+    MXC_DMA_REQUEST_I2C2TX = 0x2C,
+} mxc_dma_reqsel_t;
+
+typedef enum {
+    MXC_DMA_WIDTH_BYTE,
+    MXC_DMA_WIDTH_HALFWORD,
+    MXC_DMA_WIDTH_WORD,
+} mxc_dma_width_t;
+
+typedef struct {
+    int ch;
+    mxc_dma_reqsel_t reqsel;
+    mxc_dma_width_t srcwd;
+    mxc_dma_width_t dstwd;
+    int srcinc_en;
+    int dstinc_en;
+} mxc_dma_config_t;
+
+typedef struct {
+    int ch;
+    void *source;
+    void *dest;
+    int len;
+} mxc_dma_srcdst_t;
+
+int MXC_DMA_Init(void);
+int MXC_DMA_AcquireChannel(void);
+int MXC_DMA_ReleaseChannel(int ch);
+int MXC_DMA_ConfigChannel(mxc_dma_config_t config, mxc_dma_srcdst_t srcdst);
+int MXC_DMA_Start(int ch);
+int MXC_DMA_Stop(int ch);
+
+/**
+ * @brief Current source, destination and remaining count of a channel
+ *
+ * @param srcdst Channel to read, filled in with its registers
+ * @return int E_NO_ERROR or E_BAD_PARAM
+ */
+int MXC_DMA_GetSrcDst(mxc_dma_srcdst_t *srcdst);
+
+/**
+ * @brief DMA interrupt handler, transfers complete on their own in the
+ * simulation so this does nothing
+ *
+ */
+void MXC_DMA_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_DMA */
@@ -0,0 +1,63 @@
+/**
+ * @file flc.h
+ * @brief Simulated MSDK flash controller
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_FLC
+#define SIM_FLC
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile uint32_t intr;
+} mxc_flc_regs_t;
+
+extern mxc_flc_regs_t sim_flc_regs;
+
+#define MXC_FLC0 (&sim_flc_regs)
+
+#define MXC_F_FLC_INTR_DONE (1U << 0)
+#define MXC_F_FLC_INTR_AF (1U << 1)
+#define MXC_F_FLC_INTR_DONEIE (1U << 8)
+#define MXC_F_FLC_INTR_AFIE (1U << 9)
+
+int MXC_FLC_Init(void);
+int MXC_FLC_EnableInt(uint32_t flags);
+int MXC_FLC_DisableInt(uint32_t flags);
+
+/**
+ * @brief Erase a page back to all ones
+ *
+ * @param address Any address inside the page
+ * @return int E_NO_ERROR or E_BAD_PARAM
+ */
+int MXC_FLC_PageErase(uint32_t address);
+
+/**
+ * @brief Program flash, bits can only be cleared like on the device
+ *
+ * @param address Flash address
+ * @param length Length in bytes
+ * @param buffer Data to program
+ * @return int E_NO_ERROR or E_BAD_PARAM
+ */
+int MXC_FLC_Write(uint32_t address, uint32_t length, uint32_t *buffer);
+void MXC_FLC_Read(int address, void *buffer, int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_FLC */
@@ -0,0 +1,126 @@
+/**
+ * @file i2c.h
+ * @brief Simulated MSDK I2C driver
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_I2C
+#define SIM_I2C
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Registers of the I2C block touched directly by the firmware
+ *
+ */
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t intfl0;
+    volatile uint32_t inten0;
+    volatile uint32_t intfl1;
+    volatile uint32_t inten1;
+    volatile uint32_t dma;
+} mxc_i2c_regs_t;
+
+extern mxc_i2c_regs_t sim_i2c_regs[3];
+
+#define MXC_I2C0 (&sim_i2c_regs[0])
+#define MXC_I2C1 (&sim_i2c_regs[1])
+#define MXC_I2C2 (&sim_i2c_regs[2])
+
+#define MXC_I2C_GET_IDX(p) \
+    ((p) == MXC_I2C0 ? 0 : (p) == MXC_I2C1 ? 1 : (p) == MXC_I2C2 ? 2 : -1)
+#define MXC_I2C_GET_IRQ(i)                                   \
+    ((IRQn_Type)((i) == 0   ? I2C0_IRQn                      \
+                 : (i) == 1 ? I2C1_IRQn                      \
+                 : (i) == 2 ? I2C2_IRQn                      \
+                            : 0))
+
+// Bit positions match the MAX78000 INTFL0/INTEN0 registers
+#define MXC_F_I2C_CTRL_GC_ADDR_EN (1U << 2)
+
+#define MXC_F_I2C_INTFL0_DONE (1U << 0)
+#define MXC_F_I2C_INTFL0_GC_ADDR_MATCH (1U << 2)
+#define MXC_F_I2C_INTFL0_ADDR_MATCH (1U << 3)
+#define MXC_F_I2C_INTFL0_RX_THD (1U << 4)
+#define MXC_F_I2C_INTFL0_TX_THD (1U << 5)
+#define MXC_F_I2C_INTFL0_STOP (1U << 6)
+#define MXC_F_I2C_INTFL0_ADDR_NACK_ERR (1U << 10)
+#define MXC_F_I2C_INTFL0_TX_LOCKOUT (1U << 15)
+#define MXC_F_I2C_INTFL0_RD_ADDR_MATCH (1U << 22)
+#define MXC_F_I2C_INTFL0_WR_ADDR_MATCH (1U << 23)
+
+#define MXC_F_I2C_INTEN0_DONE MXC_F_I2C_INTFL0_DONE
+#define MXC_F_I2C_INTEN0_GC_ADDR_MATCH MXC_F_I2C_INTFL0_GC_ADDR_MATCH
+#define MXC_F_I2C_INTEN0_ADDR_MATCH MXC_F_I2C_INTFL0_ADDR_MATCH
+#define MXC_F_I2C_INTEN0_RX_THD MXC_F_I2C_INTFL0_RX_THD
+#define MXC_F_I2C_INTEN0_TX_THD MXC_F_I2C_INTFL0_TX_THD
+#define MXC_F_I2C_INTEN0_STOP MXC_F_I2C_INTFL0_STOP
+#define MXC_F_I2C_INTEN0_TX_LOCKOUT MXC_F_I2C_INTFL0_TX_LOCKOUT
+#define MXC_F_I2C_INTEN0_RD_ADDR_MATCH MXC_F_I2C_INTFL0_RD_ADDR_MATCH
+#define MXC_F_I2C_INTEN0_WR_ADDR_MATCH MXC_F_I2C_INTFL0_WR_ADDR_MATCH
+
+#define MXC_F_I2C_DMA_TX_EN (1U << 0)
+#define MXC_F_I2C_DMA_RX_EN (1U << 1)
+
+#define MXC_I2C_STD_MODE 100000
+#define MXC_I2C_FAST_SPEED 400000
+#define MXC_I2C_FASTPLUS_SPEED 1000000
+
+typedef struct _i2c_req_t mxc_i2c_req_t;
+typedef void (*mxc_i2c_complete_cb_t)(mxc_i2c_req_t *req, int result);
+
+struct _i2c_req_t {
+    mxc_i2c_regs_t *i2c;
+    unsigned int addr;
+    unsigned char *tx_buf;
+    unsigned int tx_len;
+    unsigned char *rx_buf;
+    unsigned int rx_len;
+    int restart;
+    mxc_i2c_complete_cb_t callback;
+};
+
+int MXC_I2C_Init(mxc_i2c_regs_t *i2c, int masterMode, unsigned int slaveAddr);
+int MXC_I2C_Shutdown(mxc_i2c_regs_t *i2c);
+int MXC_I2C_SetFrequency(mxc_i2c_regs_t *i2c, unsigned int hz);
+unsigned int MXC_I2C_GetFrequency(mxc_i2c_regs_t *i2c);
+int MXC_I2C_SetClockStretching(mxc_i2c_regs_t *i2c, int enable);
+void MXC_I2C_DisablePreload(mxc_i2c_regs_t *i2c);
+
+void MXC_I2C_EnableInt(mxc_i2c_regs_t *i2c, unsigned int flags0,
+                       unsigned int flags1);
+void MXC_I2C_DisableInt(mxc_i2c_regs_t *i2c, unsigned int flags0,
+                        unsigned int flags1);
+void MXC_I2C_ClearFlags(mxc_i2c_regs_t *i2c, unsigned int flags0,
+                        unsigned int flags1);
+
+int MXC_I2C_GetRXFIFOAvailable(mxc_i2c_regs_t *i2c);
+int MXC_I2C_GetTXFIFOAvailable(mxc_i2c_regs_t *i2c);
+int MXC_I2C_ReadRXFIFO(mxc_i2c_regs_t *i2c, volatile unsigned char *bytes,
+                       unsigned int len);
+int MXC_I2C_WriteTXFIFO(mxc_i2c_regs_t *i2c,
+                        volatile const unsigned char *bytes, unsigned int len);
+void MXC_I2C_ClearRXFIFO(mxc_i2c_regs_t *i2c);
+void MXC_I2C_ClearTXFIFO(mxc_i2c_regs_t *i2c);
+
+int MXC_I2C_MasterTransaction(mxc_i2c_req_t *req);
+int MXC_I2C_MasterTransactionDMA(mxc_i2c_req_t *req);
+int MXC_I2C_Stop(mxc_i2c_regs_t *i2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_I2C */
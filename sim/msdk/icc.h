@@ -0,0 +1,36 @@
+/**
+ * @file icc.h
+ * @brief Simulated MSDK instruction cache controller
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_ICC
+#define SIM_ICC
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile unsigned int ctrl;
+} mxc_icc_regs_t;
+
+extern mxc_icc_regs_t sim_icc_regs;
+
+#define MXC_ICC0 (&sim_icc_regs)
+
+void MXC_ICC_Enable(mxc_icc_regs_t *icc);
+void MXC_ICC_Disable(mxc_icc_regs_t *icc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_ICC */
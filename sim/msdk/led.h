@@ -0,0 +1,28 @@
+/**
+ * @file led.h
+ * @brief Simulated board LEDs
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_LED
+#define SIM_LED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LED1 0
+#define LED2 1
+#define LED3 2
+
+void LED_On(unsigned int idx);
+void LED_Off(unsigned int idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_LED */
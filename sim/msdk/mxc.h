@@ -0,0 +1,28 @@
+/**
+ * @file mxc.h
+ * @brief Simulated MSDK umbrella header
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_MXC
+#define SIM_MXC
+
+#include "aes.h"
+#include "board.h"
+#include "crc.h"
+#include "dma.h"
+#include "flc.h"
+#include "i2c.h"
+#include "icc.h"
+#include "led.h"
+#include "mxc_delay.h"
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+#include "nvic_table.h"
+#include "trng.h"
+
+#endif /* SIM_MXC */
@@ -0,0 +1,27 @@
+/**
+ * @file mxc_delay.h
+ * @brief Simulated MSDK busy delay
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_MXC_DELAY
+#define SIM_MXC_DELAY
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MXC_DELAY_MSEC(ms) ((ms) * 1000UL)
+
+int MXC_Delay(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_MXC_DELAY */
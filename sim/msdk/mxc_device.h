@@ -0,0 +1,38 @@
+/**
+ * @file mxc_device.h
+ * @brief Simulated MAX78000 device definitions
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_MXC_DEVICE
+#define SIM_MXC_DEVICE
+
+#include "core_cm4.h"
+#include "system_max78000.h"
+
+#include <stdint.h>
+
+#ifndef __packed
+    #define __packed __attribute__((__packed__))
+#endif
+
+// Internal flash, same layout as the MAX78000
+#define MXC_FLASH_MEM_BASE 0x10000000UL
+#define MXC_FLASH_MEM_SIZE 0x00080000UL
+#define MXC_FLASH_PAGE_SIZE 0x00002000UL
+
+#define MXC_DMA_CHANNELS 16
+
+typedef enum {
+    FLC0_IRQn = 23,
+    DMA0_IRQn = 28,
+    I2C0_IRQn = 13,
+    I2C1_IRQn = 36,
+    I2C2_IRQn = 62,
+    MXC_IRQ_COUNT = 128
+} IRQn_Type;
+
+#endif /* SIM_MXC_DEVICE */
@@ -0,0 +1,33 @@
+/**
+ * @file mxc_sys.h
+ * @brief Simulated system control and interrupt masking
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_MXC_SYS
+#define SIM_MXC_SYS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Mask interrupts, simulated ISRs wait until the matching exit
+ *
+ */
+void MXC_SYS_Crit_Enter(void);
+
+/**
+ * @brief Unmask interrupts
+ *
+ */
+void MXC_SYS_Crit_Exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_MXC_SYS */
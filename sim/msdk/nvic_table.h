@@ -0,0 +1,43 @@
+/**
+ * @file nvic_table.h
+ * @brief Simulated interrupt vector table
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_NVIC_TABLE
+#define SIM_NVIC_TABLE
+
+#include "mxc_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Install an interrupt handler
+ *
+ * @param irqn Interrupt number
+ * @param irq_callback Handler to call from the simulated interrupt
+ */
+void MXC_NVIC_SetVector(IRQn_Type irqn, void (*irq_callback)(void));
+
+/**
+ * @brief Enable an interrupt
+ *
+ * Enabling the I2C interrupt of a peripheral attaches it to the simulated bus
+ *
+ * @param irqn Interrupt number
+ */
+void NVIC_EnableIRQ(IRQn_Type irqn);
+
+void __enable_irq(void);
+void __disable_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_NVIC_TABLE */
@@ -0,0 +1,26 @@
+/**
+ * @file system_max78000.h
+ * @brief Simulated MAX78000 system clock
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_SYSTEM_MAX78000
+#define SIM_SYSTEM_MAX78000
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Core clock in Hz, the 100MHz IPO like on the device
+extern uint32_t SystemCoreClock;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_SYSTEM_MAX78000 */
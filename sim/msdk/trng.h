@@ -0,0 +1,32 @@
+/**
+ * @file trng.h
+ * @brief Simulated MSDK TRNG, backed by the host's random source
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_TRNG
+#define SIM_TRNG
+
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int MXC_TRNG_Init(void);
+int MXC_TRNG_Shutdown(void);
+int MXC_TRNG_RandomInt(void);
+int MXC_TRNG_Random(uint8_t *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_TRNG */
@@ -0,0 +1,37 @@
+/**
+ * @file uart.h
+ * @brief Simulated MSDK UART driver, only the console's receive status
+ * @version 0.1
+ *
+ * The console itself is the process's stdin and stdout
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM_UART
+#define SIM_UART
+
+#include "mxc_device.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile uint32_t status;
+} mxc_uart_regs_t;
+
+extern mxc_uart_regs_t sim_uart_regs[3];
+
+#define MXC_UART_GET_UART(i) (&sim_uart_regs[i])
+
+unsigned int MXC_UART_GetRXFIFOAvailable(mxc_uart_regs_t *uart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_UART */
@@ -0,0 +1,176 @@
+/**
+ * @file sim.h
+ * @brief Internal interface of the host-native MSDK simulation
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SIM
+#define SIM
+
+#include "mxc_device.h"
+
+#include <stdint.h>
+
+namespace sim {
+    // Bytes in the I2C RX and TX FIFOs
+    constexpr const uint32_t I2C_FIFO_DEPTH = 8;
+
+    // Largest single write or read phase on the simulated bus
+    constexpr const uint32_t BUS_MAX_LEN = 256;
+
+    // SCL cycles per byte on the wire (8 data bits plus ACK)
+    constexpr const uint64_t BUS_CYCLES_PER_BYTE = 9;
+
+    // SCL cycles charged for a START, repeated START or STOP condition
+    constexpr const uint64_t BUS_CYCLES_PER_CONDITION = 1;
+
+    /**
+     * @brief Bus time of a number of SCL cycles
+     *
+     * @param cycles SCL cycles
+     * @param freq Bus frequency in Hz
+     * @return uint64_t Time in microseconds
+     */
+    constexpr uint64_t cycles_to_us(const uint64_t cycles,
+                                    const uint32_t freq) {
+        return freq == 0 ? 0 : (cycles * 1000000ULL + freq - 1) / freq;
+    }
+
+    /**
+     * @brief Monotonic host time
+     *
+     * @return uint64_t Time in microseconds
+     */
+    uint64_t now_us();
+
+    /**
+     * @brief Busy-wait to charge simulated time
+     *
+     * @param us Time in microseconds
+     */
+    void spin_us(uint64_t us);
+
+    /**
+     * @brief Mask interrupts for the calling thread
+     *
+     * Simulated ISRs run on their own thread and take the same lock, so a
+     * masked section is never interrupted. Nesting is allowed
+     */
+    void irq_lock();
+
+    /**
+     * @brief Undo one irq_lock
+     *
+     */
+    void irq_unlock();
+
+    /**
+     * @brief Run the installed handler of an enabled interrupt
+     *
+     * @param irqn Interrupt number
+     */
+    void raise_irq(IRQn_Type irqn);
+
+    /**
+     * @brief Hand a byte a peripheral received to the DMA channel serving its
+     * request line
+     *
+     * @param reqsel Request line of the peripheral
+     * @param byte Byte received
+     * @return bool Whether an enabled channel took the byte
+     */
+    bool dma_to_memory(int reqsel, uint8_t byte);
+
+    /**
+     * @brief Take the next byte a DMA channel sends to a peripheral
+     *
+     * @param reqsel Request line of the peripheral
+     * @param byte Byte to send
+     * @return bool Whether an enabled channel had a byte left
+     */
+    bool dma_from_memory(int reqsel, uint8_t *byte);
+
+    /**
+     * @brief Start a component process attached to the bus
+     *
+     * @param path Component executable
+     */
+    void spawn_device(const char *path);
+
+    /**
+     * @brief Wait for every spawned component to attach to the bus
+     *
+     */
+    void wait_devices();
+
+    /**
+     * @brief Serve bus operations from the controller on a background thread
+     *
+     * @param fd Socket connected to the controller
+     */
+    void serve_device(int fd);
+
+    /**
+     * @brief Tell the controller this component responds to an address
+     *
+     * @param addr 7-bit address
+     * @param freq Fastest bus frequency the component keeps up with
+     */
+    void announce_device(uint8_t addr, uint32_t freq);
+
+    /**
+     * @brief Run a controller transaction on the bus and charge its time
+     *
+     * Follows the MSDK MasterTransaction sequence: START, address and write
+     * phase, repeated START, address and read phase, then a STOP unless
+     * restart is set
+     *
+     * @param addr 7-bit address, 0 for a general call
+     * @param tx Bytes to write
+     * @param tx_len Number of bytes to write
+     * @param rx Buffer for the bytes read
+     * @param rx_len Number of bytes to read
+     * @param restart Hold the bus instead of sending a STOP
+     * @param freq Bus frequency in Hz
+     * @return int E_NO_ERROR or E_COMM_ERR if the address was not ACKed
+     */
+    int bus_transfer(uint8_t addr, const uint8_t *tx, uint32_t tx_len,
+                     uint8_t *rx, uint32_t rx_len, bool restart,
+                     uint32_t freq);
+
+    /**
+     * @brief Send a STOP if the bus is held
+     *
+     * @param freq Bus frequency in Hz
+     */
+    void bus_stop(uint32_t freq);
+
+    /**
+     * @brief Peripheral side of a write phase addressed to this component
+     *
+     * @param general_call Whether the general call address was used
+     * @param data Bytes written by the controller
+     * @param len Number of bytes
+     * @return bool Whether the address was ACKed
+     */
+    bool device_write(bool general_call, const uint8_t *data, uint32_t len);
+
+    /**
+     * @brief Peripheral side of a read phase addressed to this component
+     *
+     * @param data Buffer for the bytes sent to the controller
+     * @param len Number of bytes requested
+     */
+    void device_read(uint8_t *data, uint32_t len);
+
+    /**
+     * @brief Peripheral side of a STOP after this component was addressed
+     *
+     */
+    void device_stop();
+}  // namespace sim
+
+#endif /* SIM */
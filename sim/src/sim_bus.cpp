@@ -0,0 +1,313 @@
+/**
+ * @file sim_bus.cpp
+ * @brief Timed I2C bus model connecting the AP and component processes
+ * @version 0.1
+ *
+ * Every component runs in its own process connected to the AP with a
+ * SOCK_SEQPACKET socket. The AP process owns the bus: it routes each phase of
+ * a transaction to the addressed components and charges the time the phase
+ * takes on a real bus at the current SCL frequency. Time a component spends
+ * in its ISR before answering is clock stretching and is naturally added on
+ * top
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "sim.h"
+
+#include "mxc_errors.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+namespace sim {
+    enum class bus_op_t : uint8_t { HELLO, WRITE, READ, STOP };
+
+    struct bus_msg_t {
+        bus_op_t op;
+        uint8_t addr;
+        uint8_t ack;
+        uint8_t reserved;
+        uint32_t len;
+        uint32_t freq;
+        uint8_t data[BUS_MAX_LEN];
+    };
+
+    struct device_t {
+        int fd;
+        bool attached;
+        uint8_t addr;
+        uint32_t freq;
+        bool addressed;  // Addressed since the last STOP
+    };
+
+    // Components the AP can spawn
+    constexpr const uint32_t MAX_DEVICES = 16;
+
+    // How long the AP waits for components to attach
+    constexpr const int ATTACH_TIMEOUT_MS = 10000;
+
+    static device_t devices[MAX_DEVICES] = {};
+    static uint32_t device_cnt = 0;
+    static bool bus_held = false;
+    static const bool trace = getenv("SIM_I2C_TRACE") != nullptr;
+
+    uint64_t now_us() {
+        timespec ts = {};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL +
+               static_cast<uint64_t>(ts.tv_nsec) / 1000ULL;
+    }
+
+    void spin_us(const uint64_t us) {
+        const uint64_t deadline = now_us() + us;
+        while (now_us() < deadline) { continue; }
+    }
+
+    static void send_msg(const int fd, const bus_msg_t &msg) {
+        const size_t len = offsetof(bus_msg_t, data) + msg.len;
+        if (send(fd, &msg, len, MSG_NOSIGNAL) < 0 && errno != EPIPE) {
+            perror("sim: send");
+        }
+    }
+
+    static bool recv_msg(const int fd, bus_msg_t &msg) {
+        memset(&msg, 0, sizeof(msg));
+        return recv(fd, &msg, sizeof(msg), 0) >=
+               static_cast<ssize_t>(offsetof(bus_msg_t, data));
+    }
+
+    void spawn_device(const char *const path) {
+        if (device_cnt >= MAX_DEVICES) {
+            fprintf(stderr, "sim: too many components, ignoring %s\n", path);
+            return;
+        }
+
+        int fds[2] = {};
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+            perror("sim: socketpair");
+            exit(1);
+        }
+
+        const pid_t pid = fork();
+        if (pid < 0) {
+            perror("sim: fork");
+            exit(1);
+        } else if (pid == 0) {
+            // Components die with the AP and keep its stdout free for the
+            // host tools
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            close(fds[0]);
+            dup2(STDERR_FILENO, STDOUT_FILENO);
+
+            char fd_str[16] = {};
+            snprintf(fd_str, sizeof(fd_str), "%d", fds[1]);
+            setenv("SIM_BUS_FD", fd_str, 1);
+            execl(path, path, static_cast<char *>(nullptr));
+            perror("sim: exec");
+            _exit(1);
+        }
+
+        close(fds[1]);
+        devices[device_cnt++] = {fds[0], false, 0, 0, false};
+    }
+
+    void wait_devices() {
+        for (uint32_t i = 0; i < device_cnt; ++i) {
+            device_t &dev = devices[i];
+            pollfd pfd = {dev.fd, POLLIN, 0};
+            bus_msg_t msg = {};
+            if (poll(&pfd, 1, ATTACH_TIMEOUT_MS) != 1 ||
+                !recv_msg(dev.fd, msg) || msg.op != bus_op_t::HELLO) {
+                fprintf(stderr, "sim: component %u did not attach\n", i);
+                continue;
+            }
+            dev.attached = true;
+            dev.addr = msg.addr;
+            dev.freq = msg.freq;
+            if (trace) {
+                fprintf(stderr, "sim: component 0x%02x attached, %ukHz\n",
+                        dev.addr, dev.freq / 1000);
+            }
+        }
+    }
+
+    /**
+     * @brief Address a write phase to every matching component
+     *
+     * @return bool Whether any component ACKed
+     */
+    static bool write_phase(const uint8_t addr, const uint8_t *const tx,
+                            const uint32_t tx_len, const uint32_t freq) {
+        bool acked = false;
+        for (uint32_t i = 0; i < device_cnt; ++i) {
+            device_t &dev = devices[i];
+            if (!dev.attached || (addr != 0 && dev.addr != addr)) { continue; }
+            if (freq > dev.freq) { continue; }  // Cannot follow the clock
+
+            bus_msg_t msg = {};
+            msg.op = bus_op_t::WRITE;
+            msg.addr = addr;
+            msg.len = tx_len;
+            msg.freq = freq;
+            if (tx_len != 0) { memcpy(msg.data, tx, tx_len); }
+            send_msg(dev.fd, msg);
+
+            dev.addressed = true;
+            if (recv_msg(dev.fd, msg) && msg.ack != 0) { acked = true; }
+        }
+        return acked;
+    }
+
+    /**
+     * @brief Address a read phase to the matching component
+     *
+     * @return bool Whether the component ACKed
+     */
+    static bool read_phase(const uint8_t addr, uint8_t *const rx,
+                           const uint32_t rx_len, const uint32_t freq) {
+        for (uint32_t i = 0; i < device_cnt; ++i) {
+            device_t &dev = devices[i];
+            if (!dev.attached || dev.addr != addr || freq > dev.freq) {
+                continue;
+            }
+
+            bus_msg_t msg = {};
+            msg.op = bus_op_t::READ;
+            msg.addr = addr;
+            msg.len = sizeof(rx_len);
+            msg.freq = freq;
+            memcpy(msg.data, &rx_len, sizeof(rx_len));
+            send_msg(dev.fd, msg);
+
+            dev.addressed = true;
+            if (!recv_msg(dev.fd, msg) || msg.ack == 0) { return false; }
+            memcpy(rx, msg.data, rx_len < msg.len ? rx_len : msg.len);
+            return true;
+        }
+        return false;
+    }
+
+    static void stop_phase() {
+        for (uint32_t i = 0; i < device_cnt; ++i) {
+            device_t &dev = devices[i];
+            if (!dev.addressed) { continue; }
+            bus_msg_t msg = {};
+            msg.op = bus_op_t::STOP;
+            send_msg(dev.fd, msg);
+            dev.addressed = false;
+        }
+        bus_held = false;
+    }
+
+    int bus_transfer(const uint8_t addr, const uint8_t *const tx,
+                     const uint32_t tx_len, uint8_t *const rx,
+                     const uint32_t rx_len, const bool restart,
+                     const uint32_t freq) {
+        if (tx_len > BUS_MAX_LEN || rx_len > BUS_MAX_LEN) {
+            return E_BAD_PARAM;
+        }
+
+        const uint64_t start = now_us();
+        uint64_t cycles = 0;
+        bool acked = true;
+
+        if (tx_len != 0 || rx_len == 0) {
+            // START (or repeated START), address and data
+            cycles += BUS_CYCLES_PER_CONDITION + BUS_CYCLES_PER_BYTE;
+            acked = write_phase(addr, tx, tx_len, freq);
+            if (acked) { cycles += BUS_CYCLES_PER_BYTE * tx_len; }
+        }
+        if (acked && rx_len != 0) {
+            cycles += BUS_CYCLES_PER_CONDITION + BUS_CYCLES_PER_BYTE;
+            acked = read_phase(addr, rx, rx_len, freq);
+            if (acked) { cycles += BUS_CYCLES_PER_BYTE * rx_len; }
+        }
+
+        // A NACK always ends the transaction
+        if (!acked || !restart) {
+            cycles += BUS_CYCLES_PER_CONDITION;
+            stop_phase();
+        } else {
+            bus_held = true;
+        }
+
+        const uint64_t bus_us = cycles_to_us(cycles, freq);
+        spin_us(bus_us);
+
+        if (trace) {
+            fprintf(stderr,
+                    "sim: i2c 0x%02x w%u r%u %ukHz bus %luus total %luus%s%s\n",
+                    addr, tx_len, rx_len, freq / 1000,
+                    static_cast<unsigned long>(bus_us),
+                    static_cast<unsigned long>(now_us() - start),
+                    acked ? "" : " NACK", bus_held ? " held" : "");
+        }
+        return acked ? E_NO_ERROR : E_COMM_ERR;
+    }
+
+    void bus_stop(const uint32_t freq) {
+        if (!bus_held) { return; }
+        stop_phase();
+        spin_us(cycles_to_us(BUS_CYCLES_PER_CONDITION, freq));
+    }
+
+    // Socket to the AP when running as a component
+    static int device_fd = -1;
+
+    void announce_device(const uint8_t addr, const uint32_t freq) {
+        if (device_fd < 0) { return; }
+        bus_msg_t msg = {};
+        msg.op = bus_op_t::HELLO;
+        msg.addr = addr;
+        msg.freq = freq;
+        send_msg(device_fd, msg);
+    }
+
+    static void device_loop() {
+        bus_msg_t msg = {};
+        while (recv_msg(device_fd, msg)) {
+            switch (msg.op) {
+            case bus_op_t::WRITE:
+                msg.ack =
+                    device_write(msg.addr == 0, msg.data, msg.len) ? 1 : 0;
+                msg.len = 0;
+                send_msg(device_fd, msg);
+                break;
+            case bus_op_t::READ: {
+                uint32_t len = 0;
+                memcpy(&len, msg.data, sizeof(len));
+                if (len > BUS_MAX_LEN) { len = BUS_MAX_LEN; }
+                device_read(msg.data, len);
+                msg.ack = 1;
+                msg.len = len;
+                send_msg(device_fd, msg);
+                break;
+            }
+            case bus_op_t::STOP:
+                device_stop();
+                break;
+            default:
+                break;
+            }
+        }
+        // The AP went away
+        _exit(0);
+    }
+
+    void serve_device(const int fd) {
+        device_fd = fd;
+        std::thread(device_loop).detach();
+    }
+}  // namespace sim
@@ -0,0 +1,217 @@
+/**
+ * @file sim_core.cpp
+ * @brief Simulated core: entry point, interrupts, delays and board support
+ * @version 0.1
+ *
+ * The firmware is compiled with main renamed to firmware_main. Run without
+ * SIM_BUS_FD the process is the AP and spawns every component executable
+ * given on the command line. Run with it the process is a component: the bus
+ * socket is served on a separate thread which plays the role of the I2C
+ * interrupt. The firmware's main loop sleeps in WFE between commands, so it
+ * does not steal time from the bus on small hosts
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "sim.h"
+
+#include "board.h"
+#include "icc.h"
+#include "led.h"
+#include "mxc_delay.h"
+#include "mxc_errors.h"
+#include "mxc_sys.h"
+#include "nvic_table.h"
+#include "uart.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+int firmware_main();
+
+mxc_icc_regs_t sim_icc_regs = {};
+DWT_Type sim_dwt_regs = {};
+CoreDebug_Type sim_core_debug_regs = {};
+uint32_t SystemCoreClock = 100000000;
+
+namespace sim {
+    static std::recursive_mutex irq_mutex;
+
+    static void (*vectors[MXC_IRQ_COUNT])(void) = {};
+    static bool enabled[MXC_IRQ_COUNT] = {};
+
+    // Event register and interrupt count the sleep instructions wait on
+    static std::mutex sleep_mutex;
+    static std::condition_variable sleep_cv;
+    static bool event_register = false;
+    static uint64_t irq_count = 0;
+
+    /**
+     * @brief Wake threads sleeping in WFE, and in WFI if an interrupt was taken
+     *
+     * @param irq Whether an interrupt was taken
+     */
+    static void wake(const bool irq) {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            event_register = true;
+            if (irq) { ++irq_count; }
+        }
+        sleep_cv.notify_all();
+    }
+
+    void enable_i2c_irq(IRQn_Type irqn);
+
+    /**
+     * @brief Feed host input to the firmware's stdin like the UART would
+     *
+     * When the host closes its end the UART goes quiet instead of returning
+     * EOF, which the firmware's input loop does not expect
+     *
+     * @param host_fd Original stdin
+     * @param uart_fd Write end of the firmware's stdin
+     */
+    static void uart_rx(const int host_fd, const int uart_fd) {
+        char buf[256] = {};
+        ssize_t len = 0;
+        while ((len = read(host_fd, buf, sizeof(buf))) > 0) {
+            if (write(uart_fd, buf, static_cast<size_t>(len)) != len) { break; }
+        }
+    }
+
+    // Host time the cycle counter was last written
+    static uint64_t cyccnt_base_ns = 0;
+    static uint32_t cyccnt_base = 0;
+
+    static uint64_t now_ns() {
+        timespec ts = {};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+               static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    void irq_lock() { irq_mutex.lock(); }
+
+    void irq_unlock() { irq_mutex.unlock(); }
+
+    void raise_irq(const IRQn_Type irqn) {
+        if (irqn < 0 || irqn >= MXC_IRQ_COUNT) { return; }
+        irq_lock();
+        const bool taken = enabled[irqn] && vectors[irqn] != nullptr;
+        if (taken) { vectors[irqn](); }
+        irq_unlock();
+        if (taken) { wake(true); }
+    }
+}  // namespace sim
+
+using namespace sim;
+
+sim_cyccnt_t::operator uint32_t() const {
+    if ((sim_dwt_regs.CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        return cyccnt_base;
+    }
+    const uint64_t elapsed = now_ns() - cyccnt_base_ns;
+    const uint64_t cycles = (elapsed / 1000000000ULL) * SystemCoreClock +
+                            (elapsed % 1000000000ULL) * SystemCoreClock /
+                                1000000000ULL;
+    return cyccnt_base + static_cast<uint32_t>(cycles);
+}
+
+sim_cyccnt_t &sim_cyccnt_t::operator=(const uint32_t value) {
+    cyccnt_base = value;
+    cyccnt_base_ns = now_ns();
+    return *this;
+}
+
+void MXC_NVIC_SetVector(const IRQn_Type irqn, void (*irq_callback)(void)) {
+    if (irqn < 0 || irqn >= MXC_IRQ_COUNT) { return; }
+    vectors[irqn] = irq_callback;
+}
+
+void NVIC_EnableIRQ(const IRQn_Type irqn) {
+    if (irqn < 0 || irqn >= MXC_IRQ_COUNT) { return; }
+    enabled[irqn] = true;
+    if (irqn == I2C0_IRQn || irqn == I2C1_IRQn || irqn == I2C2_IRQn) {
+        enable_i2c_irq(irqn);
+    }
+}
+
+void __enable_irq(void) {}
+
+void __WFE(void) {
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    sleep_cv.wait(lock, []() { return event_register; });
+    event_register = false;
+}
+
+void __WFI(void) {
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    const uint64_t seen = irq_count;
+    sleep_cv.wait(lock, [seen]() { return irq_count != seen; });
+}
+
+void __SEV(void) { wake(false); }
+
+void __disable_irq(void) {}
+
+void MXC_SYS_Crit_Enter(void) { irq_lock(); }
+
+void MXC_SYS_Crit_Exit(void) { irq_unlock(); }
+
+int MXC_Delay(const uint32_t us) {
+    usleep(us);
+    return E_NO_ERROR;
+}
+
+void LED_On(unsigned int) {}
+
+void LED_Off(unsigned int) {}
+
+mxc_uart_regs_t sim_uart_regs[3] = {};
+
+unsigned int MXC_UART_GetRXFIFOAvailable(mxc_uart_regs_t *const uart) {
+    if (uart != MXC_UART_GET_UART(CONSOLE_UART)) { return 0; }
+    int available = 0;
+    if (ioctl(STDIN_FILENO, FIONREAD, &available) != 0 || available < 0) {
+        return 0;
+    }
+    return static_cast<unsigned int>(available);
+}
+
+void MXC_ICC_Enable(mxc_icc_regs_t *) {}
+
+void MXC_ICC_Disable(mxc_icc_regs_t *) {}
+
+int main(const int argc, char **const argv) {
+    const char *const bus_fd = getenv("SIM_BUS_FD");
+
+    if (bus_fd != nullptr) {
+        // Component
+        serve_device(atoi(bus_fd));
+    } else {
+        // AP: every argument is a component executable
+        for (int i = 1; i < argc; ++i) { spawn_device(argv[i]); }
+
+        int fds[2] = {};
+        const int host_fd = dup(STDIN_FILENO);
+        if (host_fd >= 0 && pipe(fds) == 0) {
+            dup2(fds[0], STDIN_FILENO);
+            close(fds[0]);
+            std::thread(uart_rx, host_fd, fds[1]).detach();
+        }
+
+        // Like the UART FIFO, bytes not read yet stay visible to
+        // MXC_UART_GetRXFIFOAvailable
+        setvbuf(stdin, nullptr, _IONBF, 0);
+    }
+
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    return firmware_main();
+}
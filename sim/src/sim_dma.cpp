@@ -0,0 +1,139 @@
+/**
+ * @file sim_dma.cpp
+ * @brief Simulated DMA controller
+ * @version 0.1
+ *
+ * Channels serving a peripheral request line move bytes between the
+ * peripheral's FIFO and memory as soon as the peripheral asks for them, which
+ * costs no time in the firmware's ISRs like on the device. Only byte wide
+ * transfers are modelled
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "dma.h"
+
+#include "mxc_errors.h"
+#include "sim.h"
+
+namespace sim {
+    struct dma_channel_t {
+        bool acquired;
+        bool enabled;
+        mxc_dma_config_t config;
+        uint8_t *source;
+        uint8_t *dest;
+        uint32_t cnt;
+    };
+
+    static dma_channel_t channels[MXC_DMA_CHANNELS] = {};
+
+    static inline bool valid_channel(const int ch) {
+        return ch >= 0 && ch < MXC_DMA_CHANNELS;
+    }
+
+    /**
+     * @brief Enabled channel with bytes left serving a request line
+     *
+     * @param reqsel Request line
+     * @return dma_channel_t* Channel or nullptr
+     */
+    static dma_channel_t *serving(const int reqsel) {
+        for (dma_channel_t &channel : channels) {
+            if (channel.enabled && channel.cnt != 0 &&
+                channel.config.reqsel == reqsel) {
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+    bool dma_to_memory(const int reqsel, const uint8_t byte) {
+        dma_channel_t *const channel = serving(reqsel);
+        if (channel == nullptr) { return false; }
+        *channel->dest = byte;
+        if (channel->config.dstinc_en != 0) { ++channel->dest; }
+        --channel->cnt;
+        return true;
+    }
+
+    bool dma_from_memory(const int reqsel, uint8_t *const byte) {
+        dma_channel_t *const channel = serving(reqsel);
+        if (channel == nullptr) { return false; }
+        *byte = *channel->source;
+        if (channel->config.srcinc_en != 0) { ++channel->source; }
+        --channel->cnt;
+        return true;
+    }
+}  // namespace sim
+
+using namespace sim;
+
+int MXC_DMA_Init(void) { return E_NO_ERROR; }
+
+void MXC_DMA_Handler(void) {}
+
+int MXC_DMA_AcquireChannel(void) {
+    irq_lock();
+    for (int ch = 0; ch < MXC_DMA_CHANNELS; ++ch) {
+        if (!channels[ch].acquired) {
+            channels[ch] = {};
+            channels[ch].acquired = true;
+            irq_unlock();
+            return ch;
+        }
+    }
+    irq_unlock();
+    return E_NONE_AVAIL;
+}
+
+int MXC_DMA_ReleaseChannel(const int ch) {
+    if (!valid_channel(ch)) { return E_BAD_PARAM; }
+    irq_lock();
+    channels[ch] = {};
+    irq_unlock();
+    return E_NO_ERROR;
+}
+
+int MXC_DMA_ConfigChannel(const mxc_dma_config_t config,
+                          const mxc_dma_srcdst_t srcdst) {
+    if (!valid_channel(config.ch) || srcdst.ch != config.ch || srcdst.len < 0) {
+        return E_BAD_PARAM;
+    }
+    if (config.srcwd != MXC_DMA_WIDTH_BYTE ||
+        config.dstwd != MXC_DMA_WIDTH_BYTE) {
+        return E_NOT_SUPPORTED;
+    }
+    irq_lock();
+    dma_channel_t &channel = channels[config.ch];
+    channel.enabled = false;
+    channel.config = config;
+    channel.source = static_cast<uint8_t *>(srcdst.source);
+    channel.dest = static_cast<uint8_t *>(srcdst.dest);
+    channel.cnt = static_cast<uint32_t>(srcdst.len);
+    irq_unlock();
+    return E_NO_ERROR;
+}
+
+int MXC_DMA_Start(const int ch) {
+    if (!valid_channel(ch)) { return E_BAD_PARAM; }
+    channels[ch].enabled = true;
+    return E_NO_ERROR;
+}
+
+int MXC_DMA_Stop(const int ch) {
+    if (!valid_channel(ch)) { return E_BAD_PARAM; }
+    channels[ch].enabled = false;
+    return E_NO_ERROR;
+}
+
+int MXC_DMA_GetSrcDst(mxc_dma_srcdst_t *const srcdst) {
+    if (srcdst == nullptr) { return E_NULL_PTR; }
+    if (!valid_channel(srcdst->ch)) { return E_BAD_PARAM; }
+    const dma_channel_t &channel = channels[srcdst->ch];
+    srcdst->source = channel.source;
+    srcdst->dest = channel.dest;
+    srcdst->len = static_cast<int>(channel.cnt);
+    return E_NO_ERROR;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file sim_i2c.cpp
+ * @brief Simulated MSDK I2C driver and peripheral register model
+ * @version 0.1
+ *
+ * In controller mode transactions are handed to the bus model. In peripheral
+ * mode the flags, interrupt enables and 8-byte FIFOs of the MAX78000 I2C block
+ * are modelled closely enough to run the firmware's ISR unchanged: address
+ * matches, RX/TX threshold levels, TX lockout and STOP all raise the I2C
+ * interrupt like on the device. With DMA enabled in the I2C block the FIFOs
+ * are serviced by the simulated DMA controller instead
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "i2c.h"
+
+#include "dma.h"
+#include "mxc_errors.h"
+#include "sim.h"
+
+#include <string.h>
+#include <thread>
+
+mxc_i2c_regs_t sim_i2c_regs[3] = {};
+
+namespace sim {
+    // RX_THD is raised once this many bytes are waiting
+    constexpr const uint32_t I2C_RX_THRESHOLD = 6;
+
+    // TX_THD is raised while at most this many bytes are queued
+    constexpr const uint32_t I2C_TX_THRESHOLD = 2;
+
+    // Upper bound of ISR invocations for one bus event
+    constexpr const uint32_t I2C_MAX_ISR_PASSES = 16;
+
+    struct fifo_t {
+        uint8_t buf[I2C_FIFO_DEPTH];
+        uint32_t cnt;
+
+        bool push(const uint8_t b) {
+            if (cnt >= I2C_FIFO_DEPTH) { return false; }
+            buf[cnt++] = b;
+            return true;
+        }
+
+        uint8_t pop() {
+            const uint8_t b = buf[0];
+            memmove(buf, buf + 1, --cnt);
+            return b;
+        }
+    };
+
+    struct i2c_state_t {
+        bool master;
+        uint8_t addr;
+        uint32_t freq;
+        fifo_t rx;
+        fifo_t tx;
+    };
+
+    static i2c_state_t i2c_state[3] = {};
+
+    static inline i2c_state_t &state_of(mxc_i2c_regs_t *const i2c) {
+        const int idx = MXC_I2C_GET_IDX(i2c);
+        return i2c_state[idx < 0 ? 0 : idx];
+    }
+
+    // Only one peripheral instance is attached to the simulated bus
+    static mxc_i2c_regs_t *peripheral = nullptr;
+
+    /**
+     * @brief Update the level-triggered FIFO flags
+     *
+     */
+    static void update_levels(mxc_i2c_regs_t *const i2c) {
+        const i2c_state_t &st = state_of(i2c);
+        if (st.rx.cnt >= I2C_RX_THRESHOLD) {
+            i2c->intfl0 |= MXC_F_I2C_INTFL0_RX_THD;
+        } else {
+            i2c->intfl0 &= ~MXC_F_I2C_INTFL0_RX_THD;
+        }
+        if (st.tx.cnt <= I2C_TX_THRESHOLD) {
+            i2c->intfl0 |= MXC_F_I2C_INTFL0_TX_THD;
+        } else {
+            i2c->intfl0 &= ~MXC_F_I2C_INTFL0_TX_THD;
+        }
+    }
+
+    /**
+     * @brief Let DMA channels drain the RX FIFO and fill the TX FIFO
+     *
+     */
+    static void service_dma(mxc_i2c_regs_t *const i2c) {
+        static const int rx_req[3] = {MXC_DMA_REQUEST_I2C0RX,
+                                      MXC_DMA_REQUEST_I2C1RX,
+                                      MXC_DMA_REQUEST_I2C2RX};
+        static const int tx_req[3] = {MXC_DMA_REQUEST_I2C0TX,
+                                      MXC_DMA_REQUEST_I2C1TX,
+                                      MXC_DMA_REQUEST_I2C2TX};
+        const int idx = MXC_I2C_GET_IDX(i2c);
+        i2c_state_t &st = state_of(i2c);
+
+        if ((i2c->dma & MXC_F_I2C_DMA_RX_EN) != 0) {
+            while (st.rx.cnt != 0 && dma_to_memory(rx_req[idx], st.rx.buf[0])) {
+                st.rx.pop();
+            }
+        }
+        if ((i2c->dma & MXC_F_I2C_DMA_TX_EN) != 0 &&
+            (i2c->intfl0 & MXC_F_I2C_INTFL0_TX_LOCKOUT) == 0) {
+            uint8_t byte = 0;
+            while (st.tx.cnt < I2C_FIFO_DEPTH &&
+                   dma_from_memory(tx_req[idx], &byte)) {
+                st.tx.push(byte);
+            }
+        }
+    }
+
+    /**
+     * @brief Run DMA and the I2C interrupt while an enabled flag is pending
+     *
+     */
+    static void service(mxc_i2c_regs_t *const i2c) {
+        const IRQn_Type irqn = MXC_I2C_GET_IRQ(MXC_I2C_GET_IDX(i2c));
+        for (uint32_t i = 0; i < I2C_MAX_ISR_PASSES; ++i) {
+            service_dma(i2c);
+            update_levels(i2c);
+            if ((i2c->intfl0 & i2c->inten0) == 0) { return; }
+            raise_irq(irqn);
+        }
+    }
+
+    bool device_write(const bool general_call, const uint8_t *const data,
+                      const uint32_t len) {
+        mxc_i2c_regs_t *const i2c = peripheral;
+        if (i2c == nullptr) { return false; }
+        if (general_call && (i2c->ctrl & MXC_F_I2C_CTRL_GC_ADDR_EN) == 0) {
+            return false;
+        }
+
+        i2c_state_t &st = state_of(i2c);
+        irq_lock();
+        i2c->intfl0 |= general_call ? MXC_F_I2C_INTFL0_GC_ADDR_MATCH
+                                    : MXC_F_I2C_INTFL0_RD_ADDR_MATCH;
+        service(i2c);
+
+        for (uint32_t i = 0; i < len; ++i) {
+            if (st.rx.cnt >= I2C_FIFO_DEPTH) {
+                // Full FIFO stretches the clock until the ISR drains it
+                service(i2c);
+            }
+            // Bytes that still do not fit are lost
+            st.rx.push(data[i]);
+            service(i2c);
+        }
+        irq_unlock();
+        return true;
+    }
+
+    void device_read(uint8_t *const data, const uint32_t len) {
+        mxc_i2c_regs_t *const i2c = peripheral;
+        if (i2c == nullptr) {
+            memset(data, 0xFF, len);
+            return;
+        }
+
+        i2c_state_t &st = state_of(i2c);
+        irq_lock();
+        // The FIFO is locked until the ISR acknowledges the address match
+        i2c->intfl0 |=
+            MXC_F_I2C_INTFL0_WR_ADDR_MATCH | MXC_F_I2C_INTFL0_TX_LOCKOUT;
+        service(i2c);
+
+        for (uint32_t i = 0; i < len; ++i) {
+            if (st.tx.cnt == 0) { service(i2c); }
+            // An empty FIFO leaves SDA released
+            data[i] = st.tx.cnt != 0 ? st.tx.pop() : 0xFF;
+        }
+        service(i2c);
+        irq_unlock();
+    }
+
+    void device_stop() {
+        mxc_i2c_regs_t *const i2c = peripheral;
+        if (i2c == nullptr) { return; }
+
+        irq_lock();
+        i2c->intfl0 |= MXC_F_I2C_INTFL0_STOP;
+        service(i2c);
+        irq_unlock();
+    }
+
+    /**
+     * @brief Attach the peripheral to the bus once its interrupt is enabled
+     *
+     * @param irqn Interrupt being enabled
+     */
+    void enable_i2c_irq(const IRQn_Type irqn) {
+        for (int idx = 0; idx < 3; ++idx) {
+            mxc_i2c_regs_t *const i2c = &sim_i2c_regs[idx];
+            const i2c_state_t &st = i2c_state[idx];
+            if (MXC_I2C_GET_IRQ(idx) != irqn || st.master) { continue; }
+            peripheral = i2c;
+            announce_device(st.addr, st.freq);
+        }
+    }
+}  // namespace sim
+
+using namespace sim;
+
+int MXC_I2C_Init(mxc_i2c_regs_t *const i2c, const int masterMode,
+                 const unsigned int slaveAddr) {
+    if (MXC_I2C_GET_IDX(i2c) < 0) { return E_NULL_PTR; }
+    i2c_state_t &st = state_of(i2c);
+    st = {};
+    st.master = masterMode != 0;
+    st.addr = static_cast<uint8_t>(slaveAddr);
+    st.freq = MXC_I2C_STD_MODE;
+    i2c->ctrl = 0;
+    i2c->intfl0 = 0;
+    i2c->inten0 = 0;
+    i2c->dma = 0;
+
+    if (st.master) { wait_devices(); }
+    return E_NO_ERROR;
+}
+
+int MXC_I2C_Shutdown(mxc_i2c_regs_t *const i2c) {
+    if (peripheral == i2c) { peripheral = nullptr; }
+    return E_NO_ERROR;
+}
+
+int MXC_I2C_SetFrequency(mxc_i2c_regs_t *const i2c, const unsigned int hz) {
+    if (hz == 0 || hz > MXC_I2C_FASTPLUS_SPEED) { return E_BAD_PARAM; }
+    state_of(i2c).freq = hz;
+    return static_cast<int>(hz);
+}
+
+unsigned int MXC_I2C_GetFrequency(mxc_i2c_regs_t *const i2c) {
+    return state_of(i2c).freq;
+}
+
+int MXC_I2C_SetClockStretching(mxc_i2c_regs_t *, int) { return E_NO_ERROR; }
+
+void MXC_I2C_DisablePreload(mxc_i2c_regs_t *) {}
+
+void MXC_I2C_EnableInt(mxc_i2c_regs_t *const i2c, const unsigned int flags0,
+                       const unsigned int flags1) {
+    i2c->inten0 |= flags0;
+    i2c->inten1 |= flags1;
+}
+
+void MXC_I2C_DisableInt(mxc_i2c_regs_t *const i2c, const unsigned int flags0,
+                        const unsigned int flags1) {
+    i2c->inten0 &= ~flags0;
+    i2c->inten1 &= ~flags1;
+}
+
+void MXC_I2C_ClearFlags(mxc_i2c_regs_t *const i2c, const unsigned int flags0,
+                        const unsigned int flags1) {
+    i2c->intfl0 &= ~flags0;
+    i2c->intfl1 &= ~flags1;
+}
+
+int MXC_I2C_GetRXFIFOAvailable(mxc_i2c_regs_t *const i2c) {
+    return static_cast<int>(state_of(i2c).rx.cnt);
+}
+
+int MXC_I2C_GetTXFIFOAvailable(mxc_i2c_regs_t *const i2c) {
+    return static_cast<int>(I2C_FIFO_DEPTH - state_of(i2c).tx.cnt);
+}
+
+int MXC_I2C_ReadRXFIFO(mxc_i2c_regs_t *const i2c,
+                       volatile unsigned char *const bytes,
+                       const unsigned int len) {
+    i2c_state_t &st = state_of(i2c);
+    unsigned int read = 0;
+    while (read < len && st.rx.cnt != 0) { bytes[read++] = st.rx.pop(); }
+    update_levels(i2c);
+    return static_cast<int>(read);
+}
+
+int MXC_I2C_WriteTXFIFO(mxc_i2c_regs_t *const i2c,
+                        volatile const unsigned char *const bytes,
+                        const unsigned int len) {
+    if ((i2c->intfl0 & MXC_F_I2C_INTFL0_TX_LOCKOUT) != 0) { return 0; }
+    i2c_state_t &st = state_of(i2c);
+    unsigned int written = 0;
+    while (written < len && st.tx.push(bytes[written])) { ++written; }
+    update_levels(i2c);
+    return static_cast<int>(written);
+}
+
+void MXC_I2C_ClearRXFIFO(mxc_i2c_regs_t *const i2c) {
+    state_of(i2c).rx.cnt = 0;
+    update_levels(i2c);
+}
+
+void MXC_I2C_ClearTXFIFO(mxc_i2c_regs_t *const i2c) {
+    state_of(i2c).tx.cnt = 0;
+    update_levels(i2c);
+}
+
+int MXC_I2C_MasterTransaction(mxc_i2c_req_t *const req) {
+    if (req == nullptr || !state_of(req->i2c).master) { return E_BAD_PARAM; }
+    return bus_transfer(static_cast<uint8_t>(req->addr), req->tx_buf,
+                        req->tx_len, req->rx_buf, req->rx_len,
+                        req->restart != 0, state_of(req->i2c).freq);
+}
+
+int MXC_I2C_MasterTransactionDMA(mxc_i2c_req_t *const req) {
+    if (req == nullptr || !state_of(req->i2c).master) { return E_BAD_PARAM; }
+
+    // The transfer runs in the background like the DMA engine, the
+    // completion callback is delivered from interrupt context
+    std::thread([req]() {
+        const int result = MXC_I2C_MasterTransaction(req);
+        if (req->callback != nullptr) {
+            irq_lock();
+            req->callback(req, result);
+            irq_unlock();
+        }
+    }).detach();
+    return E_NO_ERROR;
+}
+
+int MXC_I2C_Stop(mxc_i2c_regs_t *const i2c) {
+    if (state_of(i2c).master) { bus_stop(state_of(i2c).freq); }
+    return E_NO_ERROR;
+}
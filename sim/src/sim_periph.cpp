@@ -0,0 +1,257 @@
+/**
+ * @file sim_periph.cpp
+ * @brief Simulated CRC, TRNG, AES and flash peripherals
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "aes.h"
+#include "crc.h"
+#include "flc.h"
+#include "mxc_device.h"
+#include "mxc_errors.h"
+#include "trng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/random.h>
+
+mxc_flc_regs_t sim_flc_regs = {};
+
+namespace sim {
+    static uint32_t crc_poly = 0xEDB88320U;
+
+    static uint8_t aes_key[16] = {};
+
+    // Set SIM_FLASH to a file to keep flash contents between runs
+    static uint8_t flash[MXC_FLASH_MEM_SIZE] = {};
+    static bool flash_loaded = false;
+
+    static const uint8_t sbox[256] = {
+        0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
+        0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
+        0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26,
+        0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+        0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2,
+        0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0,
+        0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed,
+        0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+        0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f,
+        0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5,
+        0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec,
+        0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+        0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14,
+        0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c,
+        0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d,
+        0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+        0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f,
+        0x4b, 0xbd, 0x8b, 0x8a, 0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e,
+        0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+        0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+        0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f,
+        0xb0, 0x54, 0xbb, 0x16};
+
+    static inline uint8_t xtime(const uint8_t x) {
+        return static_cast<uint8_t>((x << 1) ^ ((x & 0x80) != 0 ? 0x1b : 0));
+    }
+
+    /**
+     * @brief Encrypt one block with AES-128
+     *
+     * @param out Ciphertext
+     * @param in Plaintext
+     * @param key Cipher key
+     */
+    static void aes128_encrypt_block(uint8_t *const out,
+                                     const uint8_t *const in,
+                                     const uint8_t *const key) {
+        uint8_t rk[176] = {};
+        memcpy(rk, key, 16);
+        uint8_t rcon = 0x01;
+        for (uint32_t i = 16; i < 176; i += 4) {
+            uint8_t t[4] = {rk[i - 4], rk[i - 3], rk[i - 2], rk[i - 1]};
+            if (i % 16 == 0) {
+                const uint8_t first = t[0];
+                t[0] = sbox[t[1]] ^ rcon;
+                t[1] = sbox[t[2]];
+                t[2] = sbox[t[3]];
+                t[3] = sbox[first];
+                rcon = xtime(rcon);
+            }
+            for (uint32_t j = 0; j < 4; ++j) {
+                rk[i + j] = rk[i - 16 + j] ^ t[j];
+            }
+        }
+
+        uint8_t s[16] = {};
+        for (uint32_t i = 0; i < 16; ++i) { s[i] = in[i] ^ rk[i]; }
+
+        for (uint32_t round = 1; round <= 10; ++round) {
+            uint8_t t[16] = {};
+            // SubBytes and ShiftRows
+            for (uint32_t c = 0; c < 4; ++c) {
+                for (uint32_t r = 0; r < 4; ++r) {
+                    t[4 * c + r] = sbox[s[4 * ((c + r) % 4) + r]];
+                }
+            }
+            // MixColumns
+            if (round != 10) {
+                for (uint32_t c = 0; c < 4; ++c) {
+                    uint8_t *const col = &t[4 * c];
+                    const uint8_t all = col[0] ^ col[1] ^ col[2] ^ col[3];
+                    const uint8_t first = col[0];
+                    col[0] ^= all ^ xtime(col[0] ^ col[1]);
+                    col[1] ^= all ^ xtime(col[1] ^ col[2]);
+                    col[2] ^= all ^ xtime(col[2] ^ col[3]);
+                    col[3] ^= all ^ xtime(col[3] ^ first);
+                }
+            }
+            for (uint32_t i = 0; i < 16; ++i) {
+                s[i] = t[i] ^ rk[16 * round + i];
+            }
+        }
+        memcpy(out, s, 16);
+    }
+
+    static void flash_load() {
+        if (flash_loaded) { return; }
+        flash_loaded = true;
+        memset(flash, 0xFF, sizeof(flash));
+
+        const char *const path = getenv("SIM_FLASH");
+        if (path == nullptr) { return; }
+        FILE *const fp = fopen(path, "rb");
+        if (fp == nullptr) { return; }
+        if (fread(flash, 1, sizeof(flash), fp) != sizeof(flash)) {
+            memset(flash, 0xFF, sizeof(flash));
+        }
+        fclose(fp);
+    }
+
+    static void flash_save() {
+        const char *const path = getenv("SIM_FLASH");
+        if (path == nullptr) { return; }
+        FILE *const fp = fopen(path, "wb");
+        if (fp == nullptr) { return; }
+        fwrite(flash, 1, sizeof(flash), fp);
+        fclose(fp);
+    }
+
+    static inline bool flash_range(const uint32_t address, const uint32_t len) {
+        return address >= MXC_FLASH_MEM_BASE &&
+               address - MXC_FLASH_MEM_BASE <= MXC_FLASH_MEM_SIZE &&
+               len <= MXC_FLASH_MEM_SIZE - (address - MXC_FLASH_MEM_BASE);
+    }
+}  // namespace sim
+
+using namespace sim;
+
+int MXC_CRC_Init(void) { return E_NO_ERROR; }
+
+int MXC_CRC_Shutdown(void) { return E_NO_ERROR; }
+
+void MXC_CRC_SetPoly(const uint32_t poly) { crc_poly = poly; }
+
+int MXC_CRC_Compute(mxc_crc_req_t *const req) {
+    if (req == nullptr || req->dataBuffer == nullptr) { return E_NULL_PTR; }
+
+    uint32_t crc = 0xFFFFFFFFU;
+    const uint8_t *const data =
+        reinterpret_cast<const uint8_t *>(req->dataBuffer);
+    for (uint32_t i = 0; i < req->dataLen * sizeof(uint32_t); ++i) {
+        crc ^= data[i];
+        for (uint32_t bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? crc_poly : 0);
+        }
+    }
+    req->resultCRC = ~crc;
+    return E_NO_ERROR;
+}
+
+int MXC_TRNG_Init(void) { return E_NO_ERROR; }
+
+int MXC_TRNG_Shutdown(void) { return E_NO_ERROR; }
+
+int MXC_TRNG_Random(uint8_t *const data, const uint32_t len) {
+    uint32_t filled = 0;
+    while (filled < len) {
+        const ssize_t got = getrandom(data + filled, len - filled, 0);
+        if (got <= 0) { return E_UNKNOWN; }
+        filled += static_cast<uint32_t>(got);
+    }
+    return E_NO_ERROR;
+}
+
+int MXC_TRNG_RandomInt(void) {
+    int ret = 0;
+    MXC_TRNG_Random(reinterpret_cast<uint8_t *>(&ret), sizeof(ret));
+    return ret;
+}
+
+int MXC_AES_Init(void) { return E_NO_ERROR; }
+
+int MXC_AES_Shutdown(void) { return E_NO_ERROR; }
+
+void MXC_AES_SetExtKey(const void *const key, const mxc_aes_keys_t len) {
+    if (len == MXC_AES_128BITS) { memcpy(aes_key, key, sizeof(aes_key)); }
+}
+
+int MXC_AES_Encrypt(mxc_aes_req_t *const req) {
+    if (req == nullptr || req->inputData == nullptr ||
+        req->resultData == nullptr) {
+        return E_NULL_PTR;
+    }
+    if (req->keySize != MXC_AES_128BITS ||
+        req->encryption != MXC_AES_ENCRYPT_EXT_KEY || req->length % 4 != 0) {
+        return E_NOT_SUPPORTED;
+    }
+
+    const uint8_t *const in = reinterpret_cast<const uint8_t *>(req->inputData);
+    uint8_t *const out = reinterpret_cast<uint8_t *>(req->resultData);
+    for (uint32_t i = 0; i < req->length * sizeof(uint32_t); i += 16) {
+        aes128_encrypt_block(out + i, in + i, aes_key);
+    }
+    return E_NO_ERROR;
+}
+
+int MXC_FLC_Init(void) { return E_NO_ERROR; }
+
+int MXC_FLC_EnableInt(uint32_t) { return E_NO_ERROR; }
+
+int MXC_FLC_DisableInt(uint32_t) { return E_NO_ERROR; }
+
+int MXC_FLC_PageErase(const uint32_t address) {
+    flash_load();
+    if (!flash_range(address, 1)) { return E_BAD_PARAM; }
+    const uint32_t page =
+        (address - MXC_FLASH_MEM_BASE) & ~(MXC_FLASH_PAGE_SIZE - 1);
+    memset(flash + page, 0xFF, MXC_FLASH_PAGE_SIZE);
+    flash_save();
+    return E_NO_ERROR;
+}
+
+int MXC_FLC_Write(const uint32_t address, const uint32_t length,
+                  uint32_t *const buffer) {
+    flash_load();
+    if (buffer == nullptr) { return E_NULL_PTR; }
+    if (!flash_range(address, length)) { return E_BAD_PARAM; }
+    const uint8_t *const data = reinterpret_cast<const uint8_t *>(buffer);
+    for (uint32_t i = 0; i < length; ++i) {
+        flash[address - MXC_FLASH_MEM_BASE + i] &= data[i];
+    }
+    flash_save();
+    return E_NO_ERROR;
+}
+
+void MXC_FLC_Read(const int address, void *const buffer, const int len) {
+    flash_load();
+    const uint32_t addr = static_cast<uint32_t>(address);
+    if (buffer == nullptr || len < 0 ||
+        !flash_range(addr, static_cast<uint32_t>(len))) {
+        return;
+    }
+    memcpy(buffer, flash + (addr - MXC_FLASH_MEM_BASE), len);
+}